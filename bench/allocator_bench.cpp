@@ -0,0 +1,291 @@
+// Allocator benchmark.
+// Build: g++ -std=c++17 -O2 -Isrc bench/allocator_bench.cpp -o allocator_bench
+// Usage: allocator_bench [ops] [uniform|bimodal|powerlaw] [lifo|fifo|random|churn] [seed] [backend|all]
+// Backends: linear, compact, first, best, worst, next, buddy, slab
+//
+// The operation sequence is generated once from the seed and replayed
+// against every backend, so all of them see identical requests.
+
+#include "MemoryManager.h"
+#include "IndexedMemoryManager.h"
+#include "BuddyMemoryManager.h"
+#include "SlabAllocator.h"
+#include "SchedulingMetrics.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <type_traits>
+
+static const int MEMORY_SIZE = 1 << 18;
+static const int SAMPLES = 100;         // Stats snapshots per run
+static const int SERIES_POINTS = 10;    // Snapshots printed per backend
+
+struct Op {
+    bool allocate;
+    int size;  // Allocation size
+    int id;    // Allocation this op creates or frees
+};
+
+struct Workload {
+    std::vector<Op> ops;
+    int allocations = 0;
+};
+
+struct Sample {
+    long long op;
+    int blocks;                // Allocated plus free blocks
+    double externalFragmentation;
+    double largestFreeRatio;   // Largest free block / free memory
+};
+
+struct BenchResult {
+    std::string backend;
+    double seconds = 0;
+    long long failed = 0;
+    int peakBlocks = 0;        // Largest sampled block count
+    LatencyHistogram allocLatency;
+    LatencyHistogram freeLatency;
+    std::vector<Sample> samples;
+};
+
+class SizeSource {
+private:
+    std::string distribution;
+    std::uniform_int_distribution<int> uniform{1, 64};
+    std::uniform_int_distribution<int> small{1, 8};
+    std::uniform_int_distribution<int> large{128, 256};
+    std::uniform_real_distribution<double> unit{0.0, 1.0};
+
+public:
+    explicit SizeSource(std::string _distribution) : distribution(std::move(_distribution)) {}
+
+    int next(std::mt19937& rng) {
+        if (distribution == "bimodal") {
+            return unit(rng) < 0.8 ? small(rng) : large(rng);
+        }
+        if (distribution == "powerlaw") {
+            // Pareto with alpha 1.2, capped so one request cannot take a
+            // noticeable share of memory
+            double u = 1.0 - unit(rng);
+            return static_cast<int>(std::min(4096.0, std::floor(std::pow(u, -1.0 / 1.2))));
+        }
+        return uniform(rng);
+    }
+};
+
+// Fills to a target live count, then repeatedly frees a batch chosen by the
+// free order and allocates a batch of the same size. Churn is random order
+// with single-block batches, run for the whole op count.
+static Workload makeWorkload(long long opCount, const std::string& distribution,
+                             const std::string& order, unsigned seed) {
+    std::mt19937 rng(seed);
+    SizeSource sizes(distribution);
+    const int targetLive = 4000;
+    const int batch = order == "churn" ? 1 : 500;
+
+    Workload workload;
+    workload.ops.reserve(static_cast<std::size_t>(opCount));
+    std::deque<int> live;
+    auto allocate = [&] {
+        workload.ops.push_back({true, sizes.next(rng), workload.allocations});
+        live.push_back(workload.allocations++);
+    };
+
+    while (static_cast<long long>(workload.ops.size()) < opCount) {
+        if (static_cast<int>(live.size()) < targetLive) {
+            allocate();
+            continue;
+        }
+        for (int i = 0; i < batch && !live.empty(); i++) {
+            int victim;
+            if (order == "lifo") {
+                victim = live.back();
+                live.pop_back();
+            } else if (order == "fifo") {
+                victim = live.front();
+                live.pop_front();
+            } else {
+                std::size_t pos = rng() % live.size();
+                victim = live[pos];
+                live[pos] = live.back();
+                live.pop_back();
+            }
+            workload.ops.push_back({false, 0, victim});
+        }
+        for (int i = 0; i < batch; i++) {
+            allocate();
+        }
+    }
+    workload.ops.resize(static_cast<std::size_t>(opCount));
+    return workload;
+}
+
+static Sample takeSample(const MemoryAllocator& allocator, long long op) {
+    MemoryStats stats = allocator.getStats();
+    int free = stats.freeMemory();
+    return {op, stats.allocatedBlocks + stats.freeBlocks, stats.externalFragmentation(),
+            free > 0 ? static_cast<double>(stats.largestFreeBlock) / free : 1.0};
+}
+
+// Blocks moved by compaction are looked up by their old address and given
+// the new one, as any owner of a MemoryManager block would
+template <typename Allocator>
+static void fixUpAddresses(Allocator& allocator, std::vector<int>& addressOf, std::unordered_map<int, int>& idAt) {
+    if constexpr (std::is_same<Allocator, MemoryManager>::value) {
+        std::vector<Relocation> moves = allocator.takeRelocations();
+        std::vector<int> ids;
+        for (const Relocation& move : moves) {
+            ids.push_back(idAt[move.oldStart]);
+            idAt.erase(move.oldStart);
+        }
+        for (std::size_t i = 0; i < moves.size(); i++) {
+            addressOf[ids[i]] = moves[i].newStart;
+            idAt[moves[i].newStart] = ids[i];
+        }
+    }
+}
+
+// Templated on the concrete backend so calls are not dispatched virtually
+template <typename Allocator>
+static BenchResult runBench(Allocator& allocator, const Workload& workload) {
+    using Clock = std::chrono::steady_clock;
+    constexpr bool relocates = std::is_same<Allocator, MemoryManager>::value;
+
+    BenchResult result;
+    result.backend = allocator.name();
+    std::vector<int> addressOf(static_cast<std::size_t>(workload.allocations), -1);
+    std::unordered_map<int, int> idAt;  // Address -> allocation, only for relocating backends
+    long long total = static_cast<long long>(workload.ops.size());
+    long long sampleEvery = std::max(1LL, total / SAMPLES);
+
+    auto begin = Clock::now();
+    for (long long i = 0; i < total; i++) {
+        const Op& op = workload.ops[i];
+        if (op.allocate) {
+            auto t0 = Clock::now();
+            int address = allocator.allocateMemory(op.size, "bench");
+            auto t1 = Clock::now();
+            result.allocLatency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            addressOf[op.id] = address;
+            if (address < 0) {
+                result.failed++;
+            }
+            if (relocates) {
+                fixUpAddresses(allocator, addressOf, idAt);
+                if (address >= 0) {
+                    idAt[address] = op.id;
+                }
+            }
+        } else if (addressOf[op.id] >= 0) {
+            auto t0 = Clock::now();
+            allocator.deallocateMemory(addressOf[op.id]);
+            auto t1 = Clock::now();
+            result.freeLatency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            if (relocates) {
+                idAt.erase(addressOf[op.id]);
+                fixUpAddresses(allocator, addressOf, idAt);
+            }
+            addressOf[op.id] = -1;
+        }
+
+        if ((i + 1) % sampleEvery == 0) {
+            // Sampling is left out of the timed total
+            auto pause = Clock::now();
+            result.samples.push_back(takeSample(allocator, i + 1));
+            result.peakBlocks = std::max(result.peakBlocks, result.samples.back().blocks);
+            begin += Clock::now() - pause;
+        }
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    return result;
+}
+
+template <typename Allocator>
+static void benchBackend(std::vector<BenchResult>& results, const Workload& workload, Allocator&& allocator) {
+    results.push_back(runBench(allocator, workload));
+}
+
+static void displayResults(const std::vector<BenchResult>& results, long long ops) {
+    std::cout << std::left
+              << std::setw(32) << "Backend"
+              << std::setw(12) << "Ops/sec"
+              << std::setw(9) << "Failed"
+              << std::setw(11) << "Peak Blks"
+              << std::setw(18) << "Alloc p50/p99 ns"
+              << std::setw(18) << "Free p50/p99 ns"
+              << std::setw(10) << "Ext Frag"
+              << "Largest/Free\n";
+    std::cout << "------------------------------------------------------------------------------------------------------------------------\n";
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        const Sample& last = r.samples.back();
+        std::cout << std::left
+                  << std::setw(32) << r.backend
+                  << std::setw(12) << std::setprecision(0) << (r.seconds > 0 ? ops / r.seconds : 0.0)
+                  << std::setw(9) << r.failed
+                  << std::setw(11) << r.peakBlocks
+                  << std::setw(18) << (std::to_string(r.allocLatency.percentile(0.5)) + "/" +
+                                       std::to_string(r.allocLatency.percentile(0.99)))
+                  << std::setw(18) << (std::to_string(r.freeLatency.percentile(0.5)) + "/" +
+                                       std::to_string(r.freeLatency.percentile(0.99)))
+                  << std::setw(10) << std::setprecision(3) << last.externalFragmentation
+                  << last.largestFreeRatio << "\n";
+    }
+
+    std::size_t stride = std::max<std::size_t>(1, results.front().samples.size() / SERIES_POINTS);
+    std::cout << "\nExternal fragmentation over time (every " << results.front().samples[stride - 1].op
+              << " ops)\n";
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(32) << r.backend << std::setprecision(3);
+        for (std::size_t i = stride - 1; i < r.samples.size(); i += stride) {
+            std::cout << std::setw(7) << r.samples[i].externalFragmentation;
+        }
+        std::cout << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+int main(int argc, char* argv[]) {
+    long long ops = argc > 1 ? std::atoll(argv[1]) : 100000;
+    std::string distribution = argc > 2 ? argv[2] : "uniform";
+    std::string order = argc > 3 ? argv[3] : "random";
+    unsigned seed = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 1;
+    std::string backend = argc > 5 ? argv[5] : "all";
+
+    if (ops < SAMPLES) {
+        std::cerr << "Need at least " << SAMPLES << " ops\n";
+        return 1;
+    }
+    Workload workload = makeWorkload(ops, distribution, order, seed);
+    std::cout << "Workload: " << ops << " ops, " << distribution << " sizes, " << order
+              << " frees, seed " << seed << ", " << MEMORY_SIZE << " units\n\n";
+
+    std::vector<BenchResult> results;
+    auto wanted = [&](const char* key) { return backend == "all" || backend == key; };
+    if (wanted("linear")) benchBackend(results, workload, MemoryManager(MEMORY_SIZE));
+    if (wanted("compact")) benchBackend(results, workload, MemoryManager(MEMORY_SIZE, 1024));
+    if (wanted("first")) benchBackend(results, workload, IndexedMemoryManager(MEMORY_SIZE, FitStrategy::FIRST_FIT));
+    if (wanted("best")) benchBackend(results, workload, IndexedMemoryManager(MEMORY_SIZE, FitStrategy::BEST_FIT));
+    if (wanted("worst")) benchBackend(results, workload, IndexedMemoryManager(MEMORY_SIZE, FitStrategy::WORST_FIT));
+    if (wanted("next")) benchBackend(results, workload, IndexedMemoryManager(MEMORY_SIZE, FitStrategy::NEXT_FIT));
+    if (wanted("buddy")) benchBackend(results, workload, BuddyMemoryManager(MEMORY_SIZE));
+    if (wanted("slab")) {
+        benchBackend(results, workload, SlabAllocator(std::unique_ptr<MemoryAllocator>(
+            new IndexedMemoryManager(MEMORY_SIZE, FitStrategy::FIRST_FIT))));
+    }
+
+    if (results.empty()) {
+        std::cerr << "Unknown backend " << backend << "\n";
+        return 1;
+    }
+    displayResults(results, ops);
+    return 0;
+}
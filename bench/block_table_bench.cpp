@@ -0,0 +1,163 @@
+// Block table footprint benchmark.
+// Build: g++ -std=c++17 -O2 -Isrc bench/block_table_bench.cpp -o block_table_bench
+// Usage: block_table_bench [blocks] [owners] [nameLength]
+//
+// Builds the same block list as a vector of MemoryBlock objects (one owner
+// string per block) and as a BlockTable with interned owner ids, then
+// compares memory footprint, a full free-block scan and a sort by address.
+
+#include "MemoryManager.h"
+#include "BlockTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+struct LayoutResult {
+    const char* layout;
+    std::size_t bytes;
+    double scanMs;
+    double sortMs;
+};
+
+static std::string ownerName(int owner, int length) {
+    std::string name = "P" + std::to_string(owner);
+    if (static_cast<int>(name.size()) < length) {
+        name.append(length - name.size(), '_');
+    }
+    return name;
+}
+
+static std::size_t stringHeapBytes(const std::string& s) {
+    // Short strings live inside the object (small-string optimisation)
+    return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+template <typename Fn>
+static double timeMs(Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// Best of several runs, for operations that leave their input unchanged
+template <typename Fn>
+static double bestMs(Fn&& fn, int runs = 5) {
+    double best = timeMs(fn);
+    for (int i = 1; i < runs; i++) {
+        best = std::min(best, timeMs(fn));
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int ownerCount = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int nameLength = argc > 3 ? std::atoi(argv[3]) : 24;
+
+    // Shuffled block order so both layouts have to sort
+    std::mt19937 rng(7);
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    std::vector<int> ownerOf(count);
+    for (int& owner : ownerOf) {
+        owner = static_cast<int>(rng() % ownerCount) + 1;
+    }
+
+    std::vector<MemoryBlock> objects;
+    objects.reserve(count);
+    OwnerTable owners;
+    BlockTable table;
+    for (int i = 0; i < count; i++) {
+        int slot = order[i];
+        bool allocated = slot % 2 == 0;
+        std::string name = allocated ? ownerName(ownerOf[slot], nameLength) : "";
+        objects.emplace_back(slot * 8, 8, allocated, name);
+        table.starts.push_back(slot * 8);
+        table.sizes.push_back(8);
+        table.owners.push_back(allocated ? owners.intern(name) : 0);
+        table.flags.push_back(allocated ? BlockTable::ALLOCATED : 0);
+    }
+
+    std::vector<LayoutResult> results;
+    long long sink = 0;
+
+    {
+        std::size_t bytes = objects.capacity() * sizeof(MemoryBlock);
+        for (const auto& block : objects) {
+            bytes += stringHeapBytes(block.processName);
+        }
+        // No block is large enough, so both scans read every entry
+        double scanMs = bestMs([&] {
+            std::size_t n = objects.size();
+            std::size_t i = 0;
+            // Bitwise | so neither loop has a data-dependent branch
+            while (i < n && (objects[i].allocated | (objects[i].size < 16))) {
+                i++;
+            }
+            sink += static_cast<long long>(i);
+        });
+        double sortMs = timeMs([&] {
+            std::sort(objects.begin(), objects.end(),
+                      [](const MemoryBlock& a, const MemoryBlock& b) { return a.start < b.start; });
+        });
+        results.push_back({"MemoryBlock objects", bytes, scanMs, sortMs});
+    }
+
+    {
+        std::size_t bytes = table.footprintBytes() + owners.footprintBytes();
+        double scanMs = bestMs([&] {
+            const uint8_t* flags = table.flags.data();
+            const int* sizes = table.sizes.data();
+            std::size_t n = table.size();
+            std::size_t i = 0;
+            while (i < n && (((flags[i] & BlockTable::ALLOCATED) != 0) | (sizes[i] < 16))) {
+                i++;
+            }
+            sink += static_cast<long long>(i);
+        });
+        // Sort a permutation by start, then gather each column once
+        double sortMs = timeMs([&] {
+            std::vector<uint32_t> perm(table.size());
+            std::iota(perm.begin(), perm.end(), 0u);
+            const int* starts = table.starts.data();
+            std::sort(perm.begin(), perm.end(), [starts](uint32_t a, uint32_t b) { return starts[a] < starts[b]; });
+            BlockTable sorted;
+            sorted.resize(table.size());
+            for (std::size_t i = 0; i < perm.size(); i++) {
+                sorted.starts[i] = table.starts[perm[i]];
+                sorted.sizes[i] = table.sizes[perm[i]];
+                sorted.owners[i] = table.owners[perm[i]];
+                sorted.flags[i] = table.flags[perm[i]];
+            }
+            table = std::move(sorted);
+        });
+        results.push_back({"BlockTable + OwnerTable", bytes, scanMs, sortMs});
+    }
+
+    std::cout << count << " blocks, " << ownerCount << " owners, " << nameLength << "-character names\n\n";
+    std::cout << std::left
+              << std::setw(26) << "Layout"
+              << std::setw(14) << "Bytes"
+              << std::setw(14) << "Bytes/Block"
+              << std::setw(12) << "Scan (ms)"
+              << "Sort (ms)\n";
+    std::cout << "----------------------------------------------------------------------\n";
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        std::cout << std::left
+                  << std::setw(26) << r.layout
+                  << std::setw(14) << r.bytes
+                  << std::setw(14) << std::setprecision(1) << static_cast<double>(r.bytes) / count
+                  << std::setw(12) << std::setprecision(2) << r.scanMs
+                  << r.sortMs << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    return sink == 42 ? 1 : 0;  // Keeps the scans from being optimised away
+}
@@ -0,0 +1,243 @@
+// Concurrent allocator benchmark and stress test.
+// Build: g++ -std=c++17 -O2 -pthread -Isrc bench/concurrent_alloc_bench.cpp -o concurrent_alloc_bench
+// Usage: concurrent_alloc_bench scale [maxThreads] [opsPerThread]
+//        concurrent_alloc_bench stress [threads] [opsPerThread]
+//
+// scale runs 1, 2, 4, ... maxThreads workers against one MemoryManager
+// behind a single mutex and against ConcurrentMemoryManager, both over the
+// same first-fit backend. stress fills every allocated range, including the
+// rounded-up tail of a cached block, with the owning thread's tag and fails
+// if any two live allocations ever overlap. A quarter of the blocks are
+// handed to the next thread to free, so blocks also go back through the
+// magazine of a thread that did not allocate them.
+
+#include "MemoryManager.h"
+#include "ConcurrentMemoryManager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int MEMORY_SIZE = 1 << 22;
+static const int LIVE_PER_THREAD = 64;
+
+// Baseline: every call serialised on one lock
+class LockedMemoryManager {
+private:
+    MemoryManager manager;
+    std::mutex mutex;
+
+public:
+    explicit LockedMemoryManager(int totalSize) : manager(totalSize) {}
+
+    int allocateMemory(int size, const std::string& processName) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return manager.allocateMemory(size, processName);
+    }
+
+    bool deallocateMemory(int startAddress) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return manager.deallocateMemory(startAddress);
+    }
+};
+
+struct Allocation {
+    int start;
+    int size;
+    int thread;     // Worker that allocated it
+};
+
+// Each worker keeps a ring of live blocks and replaces the oldest one per
+// step; sizes are mostly small with an occasional uncached request.
+// retire is responsible for freeing a block taken out of the ring.
+template <typename Allocator, typename OnAllocate, typename Retire>
+static long long runWorker(Allocator& allocator, int id, long long ops, OnAllocate&& onAllocate, Retire&& retire) {
+    std::mt19937 rng(static_cast<unsigned>(id) * 7919u + 1u);
+    std::uniform_int_distribution<int> small(1, 48);
+    std::uniform_int_distribution<int> large(65, 512);
+    std::vector<Allocation> ring(LIVE_PER_THREAD, Allocation{-1, 0, id});
+    long long failures = 0;
+
+    for (long long i = 0; i < ops; i++) {
+        Allocation& slot = ring[static_cast<std::size_t>(i % LIVE_PER_THREAD)];
+        if (slot.start >= 0) {
+            retire(slot);
+            slot.start = -1;
+        }
+        int size = rng() % 64 == 0 ? large(rng) : small(rng);
+        int start = allocator.allocateMemory(size, "worker");
+        if (start < 0) {
+            failures++;
+            continue;
+        }
+        slot = {start, size, id};
+        onAllocate(slot);
+    }
+    for (auto& slot : ring) {
+        if (slot.start >= 0) {
+            retire(slot);
+        }
+    }
+    return failures;
+}
+
+template <typename Allocator>
+static double timeThreads(Allocator& allocator, int threads, long long opsPerThread, long long& failures) {
+    std::atomic<long long> failed(0);
+    auto noop = [](const Allocation&) {};
+    auto deallocate = [&](const Allocation& a) { allocator.deallocateMemory(a.start); };
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] { failed += runWorker(allocator, t, opsPerThread, noop, deallocate); });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    failures = failed;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+static int runScale(int maxThreads, long long opsPerThread) {
+    std::cout << std::left
+              << std::setw(9) << "Threads"
+              << std::setw(18) << "Locked ops/sec"
+              << std::setw(18) << "Cached ops/sec"
+              << std::setw(10) << "Speedup"
+              << "Failures (locked/cached)\n";
+    std::cout << "-------------------------------------------------------------------------------\n";
+    std::cout << std::fixed << std::setprecision(0);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        // Each op is one allocation and, once the ring is full, one free
+        double totalOps = 2.0 * threads * opsPerThread;
+        long long lockedFailures = 0, cachedFailures = 0;
+
+        LockedMemoryManager locked(MEMORY_SIZE);
+        double lockedSeconds = timeThreads(locked, threads, opsPerThread, lockedFailures);
+        ConcurrentMemoryManager cached(MEMORY_SIZE);
+        double cachedSeconds = timeThreads(cached, threads, opsPerThread, cachedFailures);
+
+        std::cout << std::left
+                  << std::setw(9) << threads
+                  << std::setw(18) << totalOps / lockedSeconds
+                  << std::setw(18) << totalOps / cachedSeconds
+                  << std::setw(10) << std::setprecision(2) << lockedSeconds / cachedSeconds << std::setprecision(0)
+                  << lockedFailures << "/" << cachedFailures << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    return 0;
+}
+
+// Blocks handed from one worker to another to free
+struct Mailbox {
+    std::mutex mutex;
+    std::vector<Allocation> blocks;
+};
+
+// Every unit a live allocation holds, up to its size class for cached
+// requests, carries its owner's tag. Claiming a unit that is already
+// tagged, or finding a foreign tag when releasing, means two live
+// allocations overlapped.
+static int runStress(int threads, long long opsPerThread) {
+    ConcurrentMemoryManager allocator(MEMORY_SIZE);
+    std::vector<std::atomic<uint32_t>> owner(MEMORY_SIZE);
+    for (auto& unit : owner) {
+        unit.store(0, std::memory_order_relaxed);
+    }
+    std::vector<Mailbox> mailboxes(static_cast<std::size_t>(threads));
+    std::atomic<long long> overlaps(0);
+    std::atomic<long long> failed(0);
+    std::atomic<long long> handedOff(0);
+
+    auto claim = [&](const Allocation& a) {
+        uint32_t tag = static_cast<uint32_t>(a.thread) + 1;
+        int end = a.start + ConcurrentMemoryManager::reservedSize(a.size);
+        for (int u = a.start; u < end; u++) {
+            uint32_t expected = 0;
+            if (!owner[u].compare_exchange_strong(expected, tag, std::memory_order_acq_rel)) {
+                overlaps++;
+            }
+        }
+    };
+    auto release = [&](const Allocation& a) {
+        uint32_t tag = static_cast<uint32_t>(a.thread) + 1;
+        int end = a.start + ConcurrentMemoryManager::reservedSize(a.size);
+        for (int u = a.start; u < end; u++) {
+            if (owner[u].exchange(0, std::memory_order_acq_rel) != tag) {
+                overlaps++;
+            }
+        }
+        allocator.deallocateMemory(a.start);
+    };
+    auto drain = [&](Mailbox& mailbox) {
+        std::vector<Allocation> blocks;
+        {
+            std::lock_guard<std::mutex> lock(mailbox.mutex);
+            blocks.swap(mailbox.blocks);
+        }
+        for (const Allocation& a : blocks) {
+            release(a);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            Mailbox& inbox = mailboxes[static_cast<std::size_t>(t)];
+            Mailbox& next = mailboxes[static_cast<std::size_t>((t + 1) % threads)];
+            std::mt19937 rng(static_cast<unsigned>(t) + 104729u);
+            auto retire = [&](const Allocation& a) {
+                drain(inbox);
+                if (threads > 1 && rng() % 4 == 0) {
+                    std::lock_guard<std::mutex> lock(next.mutex);
+                    next.blocks.push_back(a);
+                    handedOff++;
+                } else {
+                    release(a);
+                }
+            };
+            failed += runWorker(allocator, t, opsPerThread, claim, retire);
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    // Blocks handed off after their receiver finished
+    for (Mailbox& mailbox : mailboxes) {
+        drain(mailbox);
+    }
+
+    allocator.drainCaches();
+    MemoryStats stats = allocator.getStats();
+    ConcurrentCacheStats cache = allocator.getCacheStats();
+    std::cout << "Threads:            " << threads << "\n"
+              << "Ops per thread:     " << opsPerThread << "\n"
+              << "Failed allocations: " << failed << "\n"
+              << "Freed by another:   " << handedOff << "\n"
+              << "Overlaps:           " << overlaps << "\n"
+              << "Live after run:     " << stats.allocatedBlocks << " blocks, "
+              << stats.allocatedMemory << " units held by the backend\n"
+              << "Cache hits:         " << cache.cacheHits << "  Refills: " << cache.refills
+              << "  Flushes: " << cache.flushes << "\n";
+    bool clean = overlaps == 0 && stats.allocatedBlocks == 0 && stats.allocatedMemory == 0;
+    std::cout << (clean ? "PASS" : "FAIL") << "\n";
+    return clean ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "scale";
+    if (mode == "stress") {
+        int threads = argc > 2 ? std::atoi(argv[2]) : 16;
+        long long ops = argc > 3 ? std::atoll(argv[3]) : 100000;
+        return runStress(std::max(1, threads), ops);
+    }
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : 64;
+    long long ops = argc > 3 ? std::atoll(argv[3]) : 100000;
+    return runScale(std::max(1, maxThreads), ops);
+}
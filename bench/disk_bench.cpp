@@ -0,0 +1,112 @@
+// Online disk scheduling benchmark.
+// Build: g++ -std=c++17 -O2 -Isrc bench/disk_bench.cpp -o disk_bench
+// Usage: disk_bench [requests=1000000] [tracks=65536] [seed]
+//
+// Keeps a fixed number of requests pending: each step admits one uniformly
+// random track and services one request, as a busy disk would. For each
+// queue depth and policy it prints the average seek distance and the
+// scheduler time per request. The last column is LOOK done the way the old
+// DiskScheduler did it, by scanning an unordered queue for every selection,
+// to show the cost the ordered map removes as the queue grows.
+
+#include "DiskScheduler.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+static volatile long long positionSink;
+
+struct Result {
+    double averageSeek;
+    double nsPerRequest;
+};
+
+static Result runOnline(DiskPolicy policy, int depth, long long requests, int tracks, unsigned seed) {
+    DiskScheduler disk(tracks / 2, tracks, policy);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> anyTrack(0, tracks - 1);
+    for (int i = 0; i < depth; i++) {
+        disk.addRequest(anyTrack(rng));
+    }
+    auto begin = std::chrono::steady_clock::now();
+    for (long long i = 0; i < requests; i++) {
+        disk.serviceNext();
+        disk.addRequest(anyTrack(rng));
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+    positionSink = disk.getPosition();
+    return {disk.getStats().averageSeek(), ns / requests};
+}
+
+// LOOK over an unordered vector: O(n) per selection
+static Result runLinearLook(int depth, long long requests, int tracks, unsigned seed) {
+    std::vector<int> queue;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> anyTrack(0, tracks - 1);
+    for (int i = 0; i < depth; i++) {
+        queue.push_back(anyTrack(rng));
+    }
+    int position = tracks / 2;
+    bool up = true;
+    long long movement = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (long long i = 0; i < requests; i++) {
+        int best = -1;
+        for (int pass = 0; pass < 2 && best < 0; pass++) {
+            for (int j = 0; j < static_cast<int>(queue.size()); j++) {
+                int track = queue[j];
+                bool ahead = up ? track >= position : track <= position;
+                if (ahead && (best < 0 || std::abs(track - position) < std::abs(queue[best] - position))) {
+                    best = j;
+                }
+            }
+            if (best < 0) {
+                up = !up;
+            }
+        }
+        movement += std::abs(queue[best] - position);
+        position = queue[best];
+        queue[best] = queue.back();
+        queue.pop_back();
+        queue.push_back(anyTrack(rng));
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+    positionSink = position;
+    return {static_cast<double>(movement) / requests, ns / requests};
+}
+
+int main(int argc, char* argv[]) {
+    long long requests = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    int tracks = argc > 2 ? std::atoi(argv[2]) : 65536;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 1;
+    const DiskPolicy policies[] = {DiskPolicy::SSTF, DiskPolicy::SCAN, DiskPolicy::C_SCAN,
+                                   DiskPolicy::LOOK, DiskPolicy::C_LOOK};
+
+    std::cout << "Requests: " << requests << ", tracks: " << tracks << "\n";
+    std::cout << "Average seek in tracks / scheduler ns per request\n\n";
+    std::cout << std::left << std::setw(8) << "Depth";
+    for (DiskPolicy policy : policies) {
+        std::cout << std::setw(18) << diskPolicyName(policy);
+    }
+    std::cout << "Linear LOOK\n";
+    std::cout << std::string(8 + 18 * 6, '-') << "\n";
+
+    for (int depth : {1, 8, 64, 512, 4096}) {
+        std::cout << std::left << std::setw(8) << depth << std::fixed;
+        for (DiskPolicy policy : policies) {
+            Result result = runOnline(policy, depth, requests, tracks, seed);
+            std::cout << std::setprecision(0) << std::setw(8) << result.averageSeek
+                      << std::setprecision(1) << std::setw(10) << result.nsPerRequest;
+        }
+        // The linear scan is quadratic in spirit; keep its run short at depth
+        long long linearRequests = std::max(1LL, requests * 64 / std::max(64, depth));
+        Result linear = runLinearLook(depth, linearRequests, tracks, seed);
+        std::cout << std::setprecision(0) << std::setw(8) << linear.averageSeek
+                  << std::setprecision(1) << linear.nsPerRequest << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    return 0;
+}
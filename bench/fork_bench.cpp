@@ -0,0 +1,76 @@
+// Copy-on-write fork benchmark.
+// Build: g++ -std=c++17 -O2 -Isrc bench/fork_bench.cpp -o fork_bench
+// Usage: fork_bench [parentPages=4096] [children=32] [seed]
+//
+// A parent touches parentPages pages, then forks children one after another
+// as a pre-forking server would. Every child is kept alive; it reads its
+// whole image and writes a fixed fraction of the pages. For each write
+// fraction the table compares frames in use under copy-on-write with an
+// eager fork that copies the whole image up front.
+
+#include "PageTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    int parentPages = argc > 1 ? std::atoi(argv[1]) : 4096;
+    int children = argc > 2 ? std::atoi(argv[2]) : 32;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 1;
+    parentPages = std::max(1, parentPages);
+    children = std::max(0, children);
+
+    std::cout << "Parent pages: " << parentPages << ", children: " << children << "\n\n";
+    std::cout << std::left
+              << std::setw(10) << "Writes"
+              << std::setw(14) << "COW Frames"
+              << std::setw(14) << "Eager Frames"
+              << std::setw(14) << "Saved"
+              << std::setw(10) << "Copies"
+              << std::setw(14) << "Eager Copies"
+              << "ms\n";
+    std::cout << "-------------------------------------------------------------------------------\n";
+    for (double fraction : {0.0, 0.01, 0.1, 0.5, 1.0}) {
+        // Room for every child to copy its whole image, so nothing is evicted
+        PageTable pageTable(parentPages * (children + 1));
+        std::mt19937 rng(seed);
+        std::vector<int> order(parentPages);
+        std::iota(order.begin(), order.end(), 0);
+        int written = static_cast<int>(fraction * parentPages);
+
+        auto begin = std::chrono::steady_clock::now();
+        pageTable.switchAddressSpace(0);
+        for (int page = 0; page < parentPages; page++) {
+            pageTable.accessPage(page, true);
+        }
+        for (int child = 1; child <= children; child++) {
+            pageTable.fork(0, child);
+            pageTable.switchAddressSpace(child);
+            for (int page = 0; page < parentPages; page++) {
+                pageTable.accessPage(page);
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+            for (int i = 0; i < written; i++) {
+                pageTable.accessPage(order[i], true);
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        long long eagerFrames = static_cast<long long>(parentPages) * (children + 1);
+        std::cout << std::left
+                  << std::setw(10) << fraction
+                  << std::setw(14) << pageTable.residentPages()
+                  << std::setw(14) << eagerFrames
+                  << std::setw(14) << pageTable.framesSaved()
+                  << std::setw(10) << pageTable.getStats().cowCopies
+                  << std::setw(14) << static_cast<long long>(parentPages) * children
+                  << std::fixed << std::setprecision(1) << ms << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    return 0;
+}
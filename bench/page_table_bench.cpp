@@ -0,0 +1,141 @@
+// Page table overhead benchmark.
+// Build: g++ -std=c++17 -O2 -Isrc bench/page_table_bench.cpp -o page_table_bench
+// Usage: page_table_bench [densePages] [seed]
+//
+// Maps the same pages into the previous hash map page table and into radix
+// tables of 2, 3 and 4 levels over a 20-bit page number, then compares table
+// memory and lookup time. Address spaces:
+//   dense      densePages contiguous pages from page 0
+//   sparse     64 regions of 16 pages at random places
+//   scattered  densePages / 64 single pages at random places
+
+#include "RadixPageTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static const int PAGE_NUMBER_BITS = 20;
+static volatile long long lookupSink = 0;
+
+// Entry layout of the hash map page table before entries were packed
+struct UnpackedEntry {
+    int frameNumber;
+    bool valid;
+    bool dirty;
+    bool referenced;
+};
+
+// glibc malloc chunk size for a request of n bytes
+static std::size_t mallocChunk(std::size_t n) {
+    return std::max<std::size_t>(32, (n + 8 + 15) & ~std::size_t(15));
+}
+
+static std::size_t hashFootprintBytes(const std::unordered_map<int, UnpackedEntry>& table) {
+    // Each node holds the next pointer and the key/value pair
+    std::size_t node = sizeof(void*) + sizeof(std::pair<const int, UnpackedEntry>);
+    return sizeof(table) + table.bucket_count() * sizeof(void*) + table.size() * mallocChunk(node);
+}
+
+static std::vector<int> makePages(const std::string& layout, int densePages, std::mt19937& rng) {
+    std::vector<int> pages;
+    std::uniform_int_distribution<int> anywhere(0, (1 << PAGE_NUMBER_BITS) - 1);
+    if (layout == "dense") {
+        for (int p = 0; p < densePages; p++) {
+            pages.push_back(p);
+        }
+    } else if (layout == "sparse") {
+        for (int region = 0; region < 64; region++) {
+            int base = anywhere(rng) & ~15;
+            for (int p = 0; p < 16; p++) {
+                pages.push_back(base + p);
+            }
+        }
+    } else {
+        for (int i = 0; i < densePages / 64; i++) {
+            pages.push_back(anywhere(rng));
+        }
+    }
+    std::sort(pages.begin(), pages.end());
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+    return pages;
+}
+
+template <typename Fn>
+static double nsPerLookup(const std::vector<int>& probes, Fn&& lookup) {
+    long long sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int page : probes) {
+        sink += lookup(page);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+    lookupSink = sink;      // Keeps the lookups from being optimised away
+    return ns / probes.size();
+}
+
+static void printRow(const std::string& layout, const std::string& table, std::size_t pages,
+                     std::size_t bytes, double ns) {
+    std::cout << std::left
+              << std::setw(11) << layout
+              << std::setw(10) << table
+              << std::setw(10) << pages
+              << std::setw(14) << bytes
+              << std::setw(12) << std::setprecision(1) << static_cast<double>(bytes) / pages
+              << std::setprecision(2) << ns << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    int densePages = argc > 1 ? std::atoi(argv[1]) : 262144;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 1;
+    densePages = std::max(64, std::min(densePages, 1 << PAGE_NUMBER_BITS));
+
+    std::cout << std::left
+              << std::setw(11) << "Layout"
+              << std::setw(10) << "Table"
+              << std::setw(10) << "Pages"
+              << std::setw(14) << "Bytes"
+              << std::setw(12) << "Bytes/Page"
+              << "ns/Lookup\n";
+    std::cout << "-----------------------------------------------------------------\n";
+    std::cout << std::fixed;
+    for (const std::string layout : {"dense", "sparse", "scattered"}) {
+        std::mt19937 rng(seed);
+        std::vector<int> pages = makePages(layout, densePages, rng);
+        std::vector<int> probes;
+        std::uniform_int_distribution<std::size_t> pick(0, pages.size() - 1);
+        for (int i = 0; i < 4000000; i++) {
+            probes.push_back(pages[pick(rng)]);
+        }
+
+        std::unordered_map<int, UnpackedEntry> hash;
+        for (int page : pages) {
+            hash[page] = {page & 0xffff, true, false, false};
+        }
+        double hashNs = nsPerLookup(probes, [&](int page) {
+            auto it = hash.find(page);
+            return it != hash.end() && it->second.valid ? it->second.frameNumber : -1;
+        });
+        printRow(layout, "hash", pages.size(), hashFootprintBytes(hash), hashNs);
+
+        for (int levels = RadixPageTable::MIN_LEVELS; levels <= RadixPageTable::MAX_LEVELS; levels++) {
+            RadixPageTable radix(levels, PAGE_NUMBER_BITS);
+            for (int page : pages) {
+                PageTableEntry& entry = radix.entryFor(page);
+                entry.frameNumber = page & 0xffff;
+                entry.valid = true;
+            }
+            double radixNs = nsPerLookup(probes, [&](int page) {
+                const PageTableEntry* entry = radix.find(page);
+                return entry != nullptr && entry->valid ? static_cast<int>(entry->frameNumber) : -1;
+            });
+            printRow(layout, "radix-" + std::to_string(levels), pages.size(), radix.footprintBytes(), radixNs);
+        }
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    return 0;
+}
@@ -0,0 +1,145 @@
+// Scheduler benchmark.
+// Build: g++ -std=c++17 -O2 -pthread -Isrc bench/scheduler_bench.cpp -o scheduler_bench
+// Usage: scheduler_bench [processCount] [quantum] [rr|compare|smp] [cores] [seed]
+//        scheduler_bench [processCount] 0 sweep [threads]
+//        scheduler_bench [processCount] [quantum] gen <output.csv>
+//        scheduler_bench 0 [quantum] replay <trace>
+
+#include "Scheduler.h"
+#include "ParameterSweep.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <memory>
+
+// Arrivals are spaced so that `cores` CPUs are kept slightly underloaded
+static std::vector<Process> makeWorkload(long long count, int cores) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> burst(1, 20);
+    std::uniform_int_distribution<int> gap(0, 24);
+    std::uniform_int_distribution<int> priority(1, 5);
+
+    std::vector<Process> workload;
+    workload.reserve(static_cast<std::size_t>(count));
+    long long arrival = 0;
+    for (long long i = 0; i < count; i++) {
+        arrival += gap(rng);
+        int p = priority(rng);
+        int b = burst(rng);
+        workload.emplace_back(static_cast<int>(i + 1), "", p, b, static_cast<int>(arrival / cores));
+    }
+    return workload;
+}
+
+static void buildWorkload(Scheduler& scheduler, long long count, int cores) {
+    std::vector<Process> workload = makeWorkload(count, cores);
+    scheduler.reserve(workload.size());
+    for (auto& p : workload) {
+        scheduler.addProcess(std::move(p));
+    }
+}
+
+// Same workload as buildWorkload, written as a CSV trace
+static void writeTrace(const char* path, long long count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> burst(1, 20);
+    std::uniform_int_distribution<int> gap(0, 24);
+    std::uniform_int_distribution<int> priority(1, 5);
+
+    std::FILE* out = std::fopen(path, "w");
+    if (out == nullptr) {
+        std::cerr << "Could not open " << path << "\n";
+        return;
+    }
+    std::fprintf(out, "pid,name,priority,burst,arrival\n");
+    long long arrival = 0;
+    for (long long i = 0; i < count; i++) {
+        arrival += gap(rng);
+        int p = priority(rng);
+        int b = burst(rng);
+        std::fprintf(out, "%lld,p%lld,%d,%d,%lld\n", i + 1, i + 1, p, b, arrival);
+    }
+    std::fclose(out);
+}
+
+int main(int argc, char* argv[]) {
+    long long count = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    int quantum = argc > 2 ? std::atoi(argv[2]) : 2;
+    std::string mode = argc > 3 ? argv[3] : "rr";
+
+    if (mode == "gen" && argc > 4) {
+        writeTrace(argv[4], count);
+        return 0;
+    }
+
+    if (mode == "replay" && argc > 4) {
+        TraceReader trace;
+        if (!trace.open(argv[4])) {
+            std::cerr << "Could not open " << argv[4] << "\n";
+            return 1;
+        }
+        Scheduler scheduler(quantum);
+        RoundRobinPolicy policy(quantum);
+        auto begin = std::chrono::steady_clock::now();
+        scheduler.replay(trace, policy, [](const Process&, int) {});
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        scheduler.getMetrics().writeReport(std::cout);
+        std::cout << "\nFormat:           " << (trace.isBinary() ? "binary" : "CSV") << "\n";
+        std::cout << "Wall time (s):    " << seconds << "\n";
+        std::cout << "Records/sec:      " << (seconds > 0 ? scheduler.getMetrics().completed() / seconds : 0.0) << "\n";
+        return 0;
+    }
+
+    if (mode == "sweep") {
+        int threads = argc > 4 ? std::atoi(argv[4]) : 0;
+        auto workload = std::make_shared<const std::vector<Process>>(makeWorkload(count, 1));
+        ParameterSweep sweep(workload);
+        auto begin = std::chrono::steady_clock::now();
+        auto results = sweep.run({1, 2, 4, 8, 16}, ParameterSweep::allPolicies(), threads);
+        auto end = std::chrono::steady_clock::now();
+
+        ParameterSweep::displayResults(results);
+        std::cout << "\nWall time (s): " << std::chrono::duration<double>(end - begin).count() << "\n";
+        return 0;
+    }
+
+    if (mode == "smp") {
+        SMPConfig config;
+        config.cores = argc > 4 ? std::atoi(argv[4]) : 4;
+        config.seed = argc > 5 ? static_cast<unsigned>(std::atoi(argv[5])) : 1;
+
+        Scheduler scheduler(quantum);
+        buildWorkload(scheduler, count, config.cores);
+        auto begin = std::chrono::steady_clock::now();
+        SMPReport report = scheduler.runSMP(config);
+        auto end = std::chrono::steady_clock::now();
+
+        SMPScheduler::displayReport(report);
+        std::cout << "\nWall time (s): " << std::chrono::duration<double>(end - begin).count() << "\n";
+        return 0;
+    }
+
+    Scheduler scheduler(quantum);
+    buildWorkload(scheduler, count, 1);
+
+    auto begin = std::chrono::steady_clock::now();
+    scheduler.runRoundRobin([](const Process&, int) {});
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    long long completed = scheduler.getMetrics().completed();
+    scheduler.getMetrics().writeReport(std::cout);
+    std::cout << "\nWall time (s):    " << seconds << "\n";
+    std::cout << "Processes/sec:    " << (seconds > 0 ? completed / seconds : 0.0) << "\n";
+
+    if (mode == "compare") {
+        std::cout << "\n";
+        Scheduler::displaySummaries(scheduler.comparePolicies());
+    }
+    return 0;
+}
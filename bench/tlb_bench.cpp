@@ -0,0 +1,99 @@
+// TLB benchmark.
+// Build: g++ -std=c++17 -O2 -Isrc bench/tlb_bench.cpp -o tlb_bench
+// Usage: tlb_bench [entries=64] [ways=4] [lru|random] [seed]
+//
+// Schedules equal CPU-bound processes with Round Robin and, on every
+// dispatch, switches the page table to the process's address space and
+// issues a fixed number of memory references per time unit. Each process
+// mostly touches a small hot set. For each process count and quantum it
+// compares an ASID-tagged TLB with one that is flushed on every context
+// switch, reporting hit rate and effective access time. There are enough
+// frames for every page, so only cold misses fault.
+
+#include "Scheduler.h"
+#include "PageTable.h"
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+static const int BURST = 200;
+static const int REFS_PER_UNIT = 100;
+static const int HOT_PAGES = 12;
+static const int ALL_PAGES = 4096;
+
+struct RunResult {
+    long long switches;
+    long long flushes;
+    double hitRate;
+    double accessNs;
+};
+
+static RunResult runOnce(int processCount, int quantum, TLBConfig config, unsigned seed) {
+    Scheduler scheduler(quantum);
+    for (int pid = 1; pid <= processCount; pid++) {
+        scheduler.addProcess(Process(pid, "P" + std::to_string(pid), 1, BURST, 0));
+    }
+
+    PageTable pageTable(processCount * ALL_PAGES);
+    pageTable.enableTLB(config);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> hot(0, HOT_PAGES - 1);
+    std::uniform_int_distribution<int> any(0, ALL_PAGES - 1);
+
+    RoundRobinPolicy policy(quantum);
+    scheduler.run(policy, [](const Process&, int) {}, [&](const Process& p, int executeTime) {
+        pageTable.switchAddressSpace(p.pid);
+        for (int i = 0; i < executeTime * REFS_PER_UNIT; i++) {
+            int page = rng() % 50 != 0 ? hot(rng) : any(rng);
+            pageTable.accessPage(page, rng() % 4 == 0);
+        }
+    });
+
+    const TLBStats& stats = pageTable.getTLB()->getStats();
+    return {stats.contextSwitches, stats.flushes, stats.hitRate(), pageTable.effectiveAccessTime()};
+}
+
+int main(int argc, char* argv[]) {
+    TLBConfig config;
+    config.entries = argc > 1 ? std::atoi(argv[1]) : 64;
+    config.ways = argc > 2 ? std::atoi(argv[2]) : 4;
+    config.replacement = argc > 3 && std::string(argv[3]) == "random" ? TLBReplacement::RANDOM : TLBReplacement::LRU;
+    unsigned seed = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 1;
+
+    std::cout << "TLB: " << config.entries << " entries, " << config.ways << "-way, "
+              << (config.replacement == TLBReplacement::LRU ? "LRU" : "random")
+              << "; 2-level page tables; 1 ns TLB, 100 ns memory\n\n";
+    std::cout << std::left
+              << std::setw(7) << "Procs"
+              << std::setw(9) << "Quantum"
+              << std::setw(10) << "Switches"
+              << std::setw(12) << "ASID Hit%"
+              << std::setw(12) << "ASID ns"
+              << std::setw(10) << "Flushes"
+              << std::setw(13) << "Flush Hit%"
+              << "Flush ns\n";
+    std::cout << "-------------------------------------------------------------------------------\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (int processes : {2, 4, 8, 32}) {
+        for (int quantum : {1, 4, 16, 64}) {
+            config.asidTagging = true;
+            RunResult tagged = runOnce(processes, quantum, config, seed);
+            config.asidTagging = false;
+            RunResult flushed = runOnce(processes, quantum, config, seed);
+            std::cout << std::left
+                      << std::setw(7) << processes
+                      << std::setw(9) << quantum
+                      << std::setw(10) << tagged.switches
+                      << std::setw(12) << tagged.hitRate * 100
+                      << std::setw(12) << tagged.accessNs
+                      << std::setw(10) << flushed.flushes
+                      << std::setw(13) << flushed.hitRate * 100
+                      << flushed.accessNs << "\n";
+        }
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    return 0;
+}
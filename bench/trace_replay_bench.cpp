@@ -0,0 +1,194 @@
+// Memory-reference trace replay benchmark.
+// Build: g++ -std=c++17 -O2 -Isrc bench/trace_replay_bench.cpp -o trace_replay_bench
+// Usage: trace_replay_bench generate <trace> [references=50000000] [seed]
+//        trace_replay_bench <trace> [frames=4096] [fifo|clock|lru|aging|all] [window=1000000]
+//        trace_replay_bench analyze <trace> [frames=4096] [tau=100000]
+//
+// generate writes a binary reference trace with phased locality: a hot set
+// of 2048 pages that jumps to a new place every 4M references, plus uniform
+// references over 2^18 pages; a quarter of references are writes. Replay
+// streams the trace through a PageTable and prints faults, write-backs,
+// throughput and the per-window fault-rate series. analyze loads the whole
+// trace and compares every policy with Belady's OPT at the given frame
+// count, prints working-set sizes for window tau, and prints the LRU miss
+// ratio curve from one stack-distance pass next to OPT at the same sizes.
+
+#include "PageTable.h"
+#include "ReferenceTrace.h"
+#include "PagingAnalysis.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static const int SERIES_POINTS = 20;
+
+static int generate(const std::string& path, long long count, unsigned seed) {
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        std::cerr << "Could not open " << path << "\n";
+        return 1;
+    }
+    uint64_t header = static_cast<uint64_t>(count);
+    std::fwrite(ReferenceTrace::MAGIC, 1, sizeof(ReferenceTrace::MAGIC), out);
+    std::fwrite(&header, sizeof(header), 1, out);
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> anyPage(0, (1 << 18) - 1);
+    std::uniform_int_distribution<int> hotPage(0, 2047);
+    int hotBase = 0;
+    std::vector<uint32_t> block;
+    block.reserve(ReferenceTrace::BLOCK_SIZE);
+    for (long long i = 0; i < count; i++) {
+        if (i % 4000000 == 0) {
+            hotBase = anyPage(rng);
+        }
+        uint32_t r = rng();
+        int page = r % 10 != 0 ? (hotBase + hotPage(rng)) & ((1 << 18) - 1) : anyPage(rng);
+        block.push_back(ReferenceTrace::encode(page, (r >> 8) % 4 == 0));
+        if (block.size() == ReferenceTrace::BLOCK_SIZE) {
+            std::fwrite(block.data(), sizeof(uint32_t), block.size(), out);
+            block.clear();
+        }
+    }
+    std::fwrite(block.data(), sizeof(uint32_t), block.size(), out);
+    std::fclose(out);
+    std::cout << "Wrote " << count << " references to " << path << "\n";
+    return 0;
+}
+
+static std::unique_ptr<ReplacementPolicy> makePolicy(const std::string& name) {
+    if (name == "fifo") return std::unique_ptr<ReplacementPolicy>(new FIFOReplacement());
+    if (name == "lru") return std::unique_ptr<ReplacementPolicy>(new LRUReplacement());
+    if (name == "aging") return std::unique_ptr<ReplacementPolicy>(new AgingReplacement());
+    return std::unique_ptr<ReplacementPolicy>(new ClockReplacement());
+}
+
+static void printReport(const char* policy, const ReplayReport& report) {
+    std::cout << "\n=== " << policy << " ===\n";
+    std::cout << "References:   " << report.references;
+    if (report.rejected > 0) {
+        std::cout << " (" << report.rejected << " outside the address space)";
+    }
+    std::cout << "\nFaults:       " << report.faults << "\n"
+              << "Write-backs:  " << report.writeBacks << "\n"
+              << std::fixed << std::setprecision(4)
+              << "Fault rate:   " << report.faultRate() << "\n"
+              << std::setprecision(1)
+              << "Throughput:   " << report.referencesPerSecond() / 1e6 << "M references/sec\n";
+
+    // Evenly spaced windows, so long traces stay readable
+    std::cout << "Fault rate by window:";
+    std::size_t n = report.windows.size();
+    std::size_t step = std::max<std::size_t>(1, n / SERIES_POINTS);
+    std::cout << std::setprecision(4);
+    for (std::size_t w = 0; w < n; w += step) {
+        std::cout << (w % (step * 10) == 0 ? "\n  " : " ") << report.windows[w].faultRate();
+    }
+    std::cout << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+static int analyze(ReferenceTrace& trace, int frames, long long tau) {
+    std::vector<std::string> policies = {"fifo", "clock", "lru", "aging"};
+    std::cout << std::left << std::setw(8) << "Policy" << std::setw(14) << "Faults" << "vs OPT\n";
+    std::cout << "------------------------------\n";
+    std::vector<long long> faults;
+    for (const std::string& name : policies) {
+        PageTable pageTable(frames, makePolicy(name), 3, 31);
+        trace.rewind();
+        faults.push_back(pageTable.replay(trace).faults);
+    }
+
+    trace.rewind();
+    PagingAnalysis analysis(trace);
+    OptResult opt = analysis.optimal(frames);
+    std::cout << std::fixed << std::setprecision(3);
+    for (std::size_t p = 0; p < policies.size(); p++) {
+        std::cout << std::left << std::setw(8) << makePolicy(policies[p])->name() << std::setw(14) << faults[p]
+                  << (opt.faults > 0 ? static_cast<double>(faults[p]) / opt.faults : 0.0) << "x\n";
+    }
+    std::cout << std::left << std::setw(8) << "OPT" << opt.faults << "\n";
+
+    WorkingSetResult ws = analysis.workingSet(tau, SERIES_POINTS);
+    std::cout << std::setprecision(1)
+              << "\nDistinct pages: " << analysis.getDistinctPages() << "\n"
+              << "Working set (tau " << tau << "): mean " << ws.mean << ", max " << ws.max << "\n  ";
+    for (double size : ws.series) {
+        std::cout << size << " ";
+    }
+    std::cout << "\n";
+
+    MissRatioCurve curve = analysis.missRatioCurve();
+    std::cout << "\n" << std::left << std::setw(10) << "Frames" << std::setw(12) << "LRU Miss" << "OPT Miss\n";
+    std::cout << "------------------------------\n" << std::setprecision(4);
+    for (int size = 64; size < curve.maxUsefulFrames() * 2; size *= 2) {
+        std::cout << std::left << std::setw(10) << size << std::setw(12) << curve.missRatio(size)
+                  << analysis.optimal(size).faultRate() << "\n";
+    }
+    for (double target : {0.10, 0.05, 0.01}) {
+        std::cout << "LRU frames for miss ratio <= " << std::setprecision(2) << target << ": "
+                  << curve.framesFor(target) << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " generate <trace> [references] [seed]\n"
+                  << "       " << argv[0] << " <trace> [frames] [fifo|clock|lru|aging|all] [window]\n"
+                  << "       " << argv[0] << " analyze <trace> [frames] [tau]\n";
+        return 1;
+    }
+    if (std::string(argv[1]) == "generate") {
+        if (argc < 3) {
+            std::cerr << "Missing trace path\n";
+            return 1;
+        }
+        long long count = argc > 3 ? std::atoll(argv[3]) : 50000000;
+        unsigned seed = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 1;
+        return generate(argv[2], count, seed);
+    }
+
+    if (std::string(argv[1]) == "analyze") {
+        ReferenceTrace trace;
+        if (argc < 3 || !trace.open(argv[2])) {
+            std::cerr << "Could not open trace\n";
+            return 1;
+        }
+        int frames = argc > 3 ? std::atoi(argv[3]) : 4096;
+        long long tau = argc > 4 ? std::atoll(argv[4]) : 100000;
+        return analyze(trace, frames, tau);
+    }
+
+    int frames = argc > 2 ? std::atoi(argv[2]) : 4096;
+    std::string which = argc > 3 ? argv[3] : "all";
+    long long window = argc > 4 ? std::atoll(argv[4]) : 1000000;
+
+    ReferenceTrace trace;
+    if (!trace.open(argv[1])) {
+        std::cerr << "Could not open " << argv[1] << "\n";
+        return 1;
+    }
+    std::cout << "Trace:  " << argv[1] << " (" << (trace.isBinary() ? "binary" : "CSV") << ")\n"
+              << "Frames: " << frames << "\n";
+
+    std::vector<std::string> policies = which == "all"
+        ? std::vector<std::string>{"fifo", "clock", "lru", "aging"}
+        : std::vector<std::string>{which};
+    for (const std::string& name : policies) {
+        PageTable pageTable(frames, makePolicy(name), 3, 31);
+        trace.rewind();
+        ReplayReport report = pageTable.replay(trace, window);
+        printReport(pageTable.getPolicy().name(), report);
+    }
+    if (trace.getMalformedLines() > 0) {
+        std::cout << "\nSkipped " << trace.getMalformedLines() << " malformed lines\n";
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Virtual disk benchmark: scheduled against FIFO order on a real file.
+// Build: g++ -std=c++17 -O2 -pthread -Isrc bench/virtual_disk_bench.cpp -o virtual_disk_bench
+// Usage: virtual_disk_bench [image=virtual_disk.img] [megabytes=256] [batch=256] [batches=16] [pool] [seed]
+//
+// The image is filled once, then each run submits batches of random 4 KiB
+// block reads or writes, either in arrival (FIFO) order or in the C-LOOK
+// order of a DiskScheduler over the image's tracks. The page cache is
+// dropped between runs and the image is opened with O_DIRECT where the
+// filesystem allows it. Pass "pool" to use the pread/pwrite thread pool
+// instead of io_uring. Latency runs from the moment a request takes one of
+// the queueDepth slots until its completion is seen, on either backend.
+// On an SSD, or with the image cached, order matters
+// little; on a rotating disk C-LOOK cuts the seeks between blocks.
+
+#include "VirtualDisk.h"
+#include "SchedulingMetrics.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+struct AlignedBuffer {
+    char* data;
+
+    AlignedBuffer(std::size_t blocks, std::size_t blockSize)
+        : data(static_cast<char*>(std::aligned_alloc(blockSize, blocks * blockSize))) {}
+    ~AlignedBuffer() { std::free(data); }
+};
+
+static void fill(VirtualDisk& disk, char* buffer, int batch) {
+    std::vector<BlockIO> requests;
+    for (long long block = 0; block < disk.getBlockCount(); block++) {
+        std::memset(buffer + requests.size() * disk.getConfig().blockSize, static_cast<int>(block & 0xff),
+                    disk.getConfig().blockSize);
+        requests.push_back({block, true, buffer + requests.size() * disk.getConfig().blockSize});
+        if (static_cast<int>(requests.size()) == batch || block + 1 == disk.getBlockCount()) {
+            disk.submitBatch(requests);
+            requests.clear();
+        }
+    }
+    disk.dropCache();
+}
+
+static void runOne(const std::string& image, long long blocks, VirtualDiskConfig config, bool scheduled,
+                   bool writes, int batch, int batches, unsigned seed) {
+    VirtualDisk disk;
+    if (!disk.open(image, blocks, config)) {
+        std::cerr << "Cannot open " << image << ": " << std::strerror(errno) << "\n";
+        std::exit(1);
+    }
+    AlignedBuffer buffer(static_cast<std::size_t>(batch), static_cast<std::size_t>(config.blockSize));
+    DiskScheduler scheduler(0, disk.trackCount(), DiskPolicy::C_LOOK);
+    LatencyHistogram latency;
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<long long> pick(0, blocks - 1);
+
+    int failed = 0;
+    for (int b = 0; b < batches; b++) {
+        std::vector<BlockIO> requests;
+        for (int i = 0; i < batch; i++) {
+            requests.push_back({pick(rng), writes, buffer.data + static_cast<std::size_t>(i) * config.blockSize});
+        }
+        if (scheduled) {
+            disk.orderBatch(requests, scheduler);
+        }
+        failed += disk.submitBatch(requests);
+        for (const BlockIO& io : requests) {
+            latency.record(io.latencyNs / 1000);
+        }
+    }
+    if (writes) {
+        disk.dropCache();
+    }
+
+    const VirtualDiskStats& stats = disk.getStats();
+    std::cout << std::left << std::fixed
+              << std::setw(8) << (writes ? "write" : "read")
+              << std::setw(7) << config.queueDepth
+              << std::setw(8) << (scheduled ? "C-LOOK" : "FIFO")
+              << std::setprecision(2)
+              << std::setw(12) << stats.seconds * 1000 / batches
+              << std::setprecision(0)
+              << std::setw(10) << stats.iops()
+              << std::setw(10) << latency.percentile(0.5)
+              << std::setw(10) << latency.percentile(0.99)
+              << failed << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+int main(int argc, char* argv[]) {
+    std::string image = argc > 1 ? argv[1] : "virtual_disk.img";
+    long long megabytes = argc > 2 ? std::atoll(argv[2]) : 256;
+    int batch = argc > 3 ? std::max(1, std::atoi(argv[3])) : 256;
+    int batches = argc > 4 ? std::max(1, std::atoi(argv[4])) : 16;
+    bool pool = argc > 5 && std::string(argv[5]) == "pool";
+    unsigned seed = argc > 6 ? static_cast<unsigned>(std::atoi(argv[6])) : 1;
+
+    VirtualDiskConfig config;
+    config.directIO = true;
+    config.useIoUring = !pool;
+    long long blocks = megabytes * 1024 * 1024 / config.blockSize;
+
+    VirtualDisk disk;
+    if (!disk.open(image, blocks, config)) {
+        std::cerr << "Cannot open " << image << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::cout << "Image: " << image << ", " << megabytes << " MiB in " << disk.trackCount() << " tracks of "
+              << config.blocksPerTrack << " blocks\n";
+    std::cout << "Backend: " << disk.backendName() << (disk.isDirect() ? ", O_DIRECT" : ", page cache")
+              << ", " << batches << " batches of " << batch << " blocks\n";
+    {
+        AlignedBuffer buffer(static_cast<std::size_t>(batch), static_cast<std::size_t>(config.blockSize));
+        fill(disk, buffer.data, batch);
+    }
+    disk.close();
+
+    std::cout << "\n" << std::left
+              << std::setw(8) << "Op"
+              << std::setw(7) << "Depth"
+              << std::setw(8) << "Order"
+              << std::setw(12) << "ms/batch"
+              << std::setw(10) << "IOPS"
+              << std::setw(10) << "p50 us"
+              << std::setw(10) << "p99 us"
+              << "Failed\n";
+    std::cout << "--------------------------------------------------------------------------\n";
+    for (bool writes : {false, true}) {
+        for (int depth : {1, 4, 32}) {
+            config.queueDepth = depth;
+            for (bool scheduled : {false, true}) {
+                runOne(image, blocks, config, scheduled, writes, batch, batches, seed);
+            }
+        }
+    }
+    return 0;
+}
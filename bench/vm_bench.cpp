@@ -0,0 +1,92 @@
+// Unified virtual memory benchmark: scheduling under memory pressure.
+// Build: g++ -std=c++17 -O2 -Isrc bench/vm_bench.cpp -o vm_bench
+// Usage: vm_bench [frames=512] [pages=256] [burst=200] [quantum=4]
+//
+// Each process owns pages pages of virtual memory and spends most of its
+// references in a 32-page working set. Round Robin interleaves them over a
+// shared pool of frames. A process blocks after each slice until one paging
+// device has serviced its faults, and the CPU runs another process meanwhile.
+// The first table raises the degree of multiprogramming at a fixed frame
+// count: CPU utilization climbs while the working sets fit, then drops
+// sharply once they no longer do (thrashing). The second table fixes 16
+// processes and shrinks the frame pool.
+
+#include "VirtualMemory.h"
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+struct Outcome {
+    long long makespan;
+    double utilization;         // Burst time over makespan
+    double meanTurnaround;
+    double faultRate;
+};
+
+static Outcome simulate(int processCount, int frames, int pages, int burst, int quantum) {
+    Scheduler scheduler(quantum);
+    for (int pid = 1; pid <= processCount; pid++) {
+        Process p(pid, "P" + std::to_string(pid), 1, burst, 0);
+        p.memorySize = pages;
+        scheduler.addProcess(p);
+    }
+    MemoryManager memory(processCount * pages);
+    PageTable pageTable(frames, std::unique_ptr<ReplacementPolicy>(new ClockReplacement()));
+    VirtualMemoryConfig config;
+    config.hotFraction = 0.98;
+    config.faultServiceTime = 0.25;     // A fault costs 25 references' worth of time
+    config.writeBackTime = 0.25;
+    VirtualMemorySystem vm(memory, pageTable, config);
+    RoundRobinPolicy policy(quantum);
+    vm.run(scheduler, policy);
+
+    const SchedulingMetrics& metrics = scheduler.getMetrics();
+    Outcome outcome;
+    outcome.makespan = metrics.getMakespan();
+    outcome.utilization = outcome.makespan > 0
+        ? static_cast<double>(processCount) * burst / outcome.makespan : 0.0;
+    outcome.meanTurnaround = metrics.turnaround().mean();
+    outcome.faultRate = vm.getReport().faultRate();
+    return outcome;
+}
+
+static void printHeader(const char* first) {
+    std::cout << std::left
+              << std::setw(12) << first
+              << std::setw(12) << "Makespan"
+              << std::setw(12) << "CPU Util"
+              << std::setw(16) << "Mean Turnaround"
+              << "Fault Rate\n";
+    std::cout << "------------------------------------------------------------\n";
+}
+
+static void printRow(int key, const Outcome& outcome) {
+    std::cout << std::left << std::fixed
+              << std::setw(12) << key
+              << std::setw(12) << outcome.makespan
+              << std::setprecision(1) << std::setw(12) << outcome.utilization * 100
+              << std::setw(16) << outcome.meanTurnaround
+              << std::setprecision(4) << outcome.faultRate << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 512;
+    int pages = argc > 2 ? std::atoi(argv[2]) : 256;
+    int burst = argc > 3 ? std::atoi(argv[3]) : 200;
+    int quantum = argc > 4 ? std::atoi(argv[4]) : 4;
+
+    std::cout << "Frames: " << frames << ", pages per process: " << pages
+              << ", burst: " << burst << ", quantum: " << quantum << "\n\n";
+    printHeader("Processes");
+    for (int processCount : {1, 2, 4, 8, 12, 16, 20, 24, 32}) {
+        printRow(processCount, simulate(processCount, frames, pages, burst, quantum));
+    }
+
+    std::cout << "\n16 processes\n";
+    printHeader("Frames");
+    for (int pool : {4096, 2048, 1024, 512, 384, 256, 128}) {
+        printRow(pool, simulate(16, pool, pages, burst, quantum));
+    }
+    return 0;
+}
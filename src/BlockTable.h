@@ -0,0 +1,127 @@
+#ifndef BLOCK_TABLE_H
+#define BLOCK_TABLE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+// Owner names stored once and referred to by a small integer id. Id 0 is
+// reserved for "no owner" (free blocks). One table can be shared by several
+// allocators so the same owner gets the same id everywhere.
+class OwnerTable {
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> ids;
+
+public:
+    OwnerTable() : names(1) {}
+
+    uint32_t intern(const std::string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(names.size());
+        names.push_back(name);
+        ids.emplace(name, id);
+        return id;
+    }
+
+    const std::string& nameOf(uint32_t id) const { return names[id]; }
+
+    std::size_t size() const { return names.size() - 1; }
+
+    // Approximate heap bytes held by the table
+    std::size_t footprintBytes() const {
+        std::size_t bytes = names.capacity() * sizeof(std::string) +
+                            ids.bucket_count() * sizeof(void*) +
+                            ids.size() * (sizeof(std::string) + sizeof(uint32_t) + 2 * sizeof(void*));
+        for (const auto& name : names) {
+            if (name.capacity() > 15) {
+                bytes += 2 * (name.capacity() + 1);     // Once in names, once as a map key
+            }
+        }
+        return bytes;
+    }
+};
+
+// Memory blocks as parallel arrays, kept sorted by start address. A scan
+// for a free block only touches the flags and sizes arrays.
+struct BlockTable {
+    static constexpr uint8_t ALLOCATED = 1;
+
+    std::vector<int> starts;
+    std::vector<int> sizes;
+    std::vector<uint32_t> owners;
+    std::vector<uint8_t> flags;
+
+    std::size_t size() const { return starts.size(); }
+
+    bool isAllocated(std::size_t i) const { return flags[i] & ALLOCATED; }
+
+    void insert(std::size_t pos, int start, int blockSize, uint32_t owner, uint8_t blockFlags) {
+        starts.insert(starts.begin() + pos, start);
+        sizes.insert(sizes.begin() + pos, blockSize);
+        owners.insert(owners.begin() + pos, owner);
+        flags.insert(flags.begin() + pos, blockFlags);
+    }
+
+    void erase(std::size_t pos) {
+        starts.erase(starts.begin() + pos);
+        sizes.erase(sizes.begin() + pos);
+        owners.erase(owners.begin() + pos);
+        flags.erase(flags.begin() + pos);
+    }
+
+    // Copies entry from over entry to; used to close gaps in place
+    void move(std::size_t to, std::size_t from) {
+        starts[to] = starts[from];
+        sizes[to] = sizes[from];
+        owners[to] = owners[from];
+        flags[to] = flags[from];
+    }
+
+    // Removes entries [first, last)
+    void erase(std::size_t first, std::size_t last) {
+        starts.erase(starts.begin() + first, starts.begin() + last);
+        sizes.erase(sizes.begin() + first, sizes.begin() + last);
+        owners.erase(owners.begin() + first, owners.begin() + last);
+        flags.erase(flags.begin() + first, flags.begin() + last);
+    }
+
+    void resize(std::size_t count) {
+        starts.resize(count);
+        sizes.resize(count);
+        owners.resize(count);
+        flags.resize(count);
+    }
+
+    // Index of the first block starting at or above address
+    std::size_t lowerBound(int address) const {
+        std::size_t lo = 0, hi = starts.size();
+        while (lo < hi) {
+            std::size_t mid = (lo + hi) / 2;
+            if (starts[mid] < address) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    // Index of the block starting at start, or size() if there is none
+    std::size_t find(int start) const {
+        std::size_t i = lowerBound(start);
+        return i < starts.size() && starts[i] == start ? i : starts.size();
+    }
+
+    std::size_t footprintBytes() const {
+        return starts.capacity() * sizeof(int) + sizes.capacity() * sizeof(int) +
+               owners.capacity() * sizeof(uint32_t) + flags.capacity() * sizeof(uint8_t);
+    }
+};
+
+#endif
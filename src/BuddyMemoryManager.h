@@ -0,0 +1,236 @@
+#ifndef BUDDY_MEMORY_MANAGER_H
+#define BUDDY_MEMORY_MANAGER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "MemoryAllocator.h"
+
+// Power-of-two buddy allocator.
+//
+// Memory is managed in units of minBlockSize. A block of order k spans
+// 2^k units and starts at a multiple of its own size, so its buddy is found
+// by flipping one address bit. Each order has a bitmap with one bit per
+// block marking it free, and a free list used as a stack. Merging clears the
+// buddy's bit without searching the list; stale list entries are skipped
+// when popped. Allocation and deallocation therefore take O(log total).
+class BuddyMemoryManager : public MemoryAllocator {
+private:
+    struct Allocation {
+        int order;
+        int requested;
+        std::string processName;
+    };
+
+    int totalMemorySize;
+    int minBlockSize;
+    int totalUnits;
+    int maxOrder;
+    std::vector<std::vector<uint64_t>> freeBits;    // [order][block / 64]
+    std::vector<std::vector<int>> freeLists;        // [order] unit offsets, may hold stale entries
+    std::vector<int> freeCount;                     // [order] blocks whose bit is set
+    std::unordered_map<int, Allocation> allocations; // start address -> allocation
+    int allocatedMemory;
+    int requestedMemory;
+
+public:
+    BuddyMemoryManager(int totalSize = 1024, int _minBlockSize = 1)
+        : totalMemorySize(totalSize), minBlockSize(std::max(1, _minBlockSize)),
+          totalUnits(totalSize / std::max(1, _minBlockSize)), maxOrder(0),
+          allocatedMemory(0), requestedMemory(0) {
+        while (maxOrder < 30 && (2 << maxOrder) <= totalUnits) {
+            maxOrder++;
+        }
+        freeBits.resize(maxOrder + 1);
+        freeLists.resize(maxOrder + 1);
+        freeCount.assign(maxOrder + 1, 0);
+        for (int order = 0; order <= maxOrder; order++) {
+            freeBits[order].assign(((totalUnits >> order) + 63) / 64, 0);
+        }
+
+        // Cover memory with the largest aligned blocks that fit; a size that
+        // is not a power of two leaves several top-level blocks
+        int unit = 0;
+        for (int order = maxOrder; order >= 0; order--) {
+            while (unit + (1 << order) <= totalUnits) {
+                pushFree(order, unit);
+                unit += 1 << order;
+            }
+        }
+    }
+
+    const char* name() const override { return "Buddy System"; }
+
+    int allocateMemory(int size, const std::string& processName) override {
+        if (size <= 0) {
+            return -1;
+        }
+        int units = (size + minBlockSize - 1) / minBlockSize;
+        int order = 0;
+        while (order <= maxOrder && (1 << order) < units) {
+            order++;
+        }
+        if (order > maxOrder) {
+            return -1; // Allocation failed
+        }
+
+        // Smallest order at or above the request with a free block
+        int found = order;
+        int unit = -1;
+        for (; found <= maxOrder; found++) {
+            unit = popFree(found);
+            if (unit >= 0) {
+                break;
+            }
+        }
+        if (unit < 0) {
+            return -1; // Allocation failed
+        }
+
+        // Split down, returning upper halves to the free lists
+        while (found > order) {
+            found--;
+            pushFree(found, unit + (1 << found));
+        }
+
+        int start = unit * minBlockSize;
+        allocations.emplace(start, Allocation{order, size, processName});
+        allocatedMemory += (1 << order) * minBlockSize;
+        requestedMemory += size;
+        return start;
+    }
+
+    bool deallocateMemory(int startAddress) override {
+        auto it = allocations.find(startAddress);
+        if (it == allocations.end()) {
+            return false;
+        }
+        int order = it->second.order;
+        allocatedMemory -= (1 << order) * minBlockSize;
+        requestedMemory -= it->second.requested;
+        allocations.erase(it);
+
+        // Merge with the buddy for as long as it is free
+        int unit = startAddress / minBlockSize;
+        while (order < maxOrder) {
+            int buddy = unit ^ (1 << order);
+            if (!testFree(order, buddy)) {
+                break;
+            }
+            clearFree(order, buddy);
+            unit = std::min(unit, buddy);
+            order++;
+        }
+        pushFree(order, unit);
+        return true;
+    }
+
+    void displayMemoryMap() override {
+        struct Row {
+            int start;
+            int size;
+            const Allocation* allocation;
+        };
+        std::vector<Row> rows;
+        for (const auto& entry : allocations) {
+            rows.push_back({entry.first, (1 << entry.second.order) * minBlockSize, &entry.second});
+        }
+        for (int order = 0; order <= maxOrder; order++) {
+            for (int block = 0; block < (totalUnits >> order); block++) {
+                if (testFree(order, block << order)) {
+                    rows.push_back({(block << order) * minBlockSize, (1 << order) * minBlockSize, nullptr});
+                }
+            }
+        }
+        std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.start < b.start; });
+
+        std::cout << "\n=== Memory Map (" << name() << ") ===\n";
+        std::cout << std::left
+                  << std::setw(10) << "Start"
+                  << std::setw(10) << "Size"
+                  << std::setw(12) << "Requested"
+                  << std::setw(15) << "Status"
+                  << "Process\n";
+        std::cout << "---------------------------------------------------------\n";
+        for (const auto& row : rows) {
+            std::cout << std::left
+                      << std::setw(10) << row.start
+                      << std::setw(10) << row.size;
+            if (row.allocation) {
+                std::cout << std::setw(12) << row.allocation->requested
+                          << std::setw(15) << "Allocated" << row.allocation->processName << "\n";
+            } else {
+                std::cout << std::setw(12) << "-"
+                          << std::setw(15) << "Free" << "N/A\n";
+            }
+        }
+
+        std::cout << "\nTotal Memory: " << totalMemorySize << " MB\n";
+        std::cout << "Allocated Memory: " << allocatedMemory << " MB ("
+                  << requestedMemory << " MB requested)\n";
+        std::cout << "Free Memory: " << (totalMemorySize - allocatedMemory) << " MB\n";
+    }
+
+    MemoryStats getStats() const override {
+        MemoryStats stats;
+        // A tail smaller than minBlockSize can never be handed out
+        stats.totalMemory = totalUnits * minBlockSize;
+        stats.allocatedMemory = allocatedMemory;
+        stats.requestedMemory = requestedMemory;
+        stats.allocatedBlocks = static_cast<int>(allocations.size());
+        for (int order = 0; order <= maxOrder; order++) {
+            stats.freeBlocks += freeCount[order];
+            if (freeCount[order] > 0) {
+                stats.largestFreeBlock = (1 << order) * minBlockSize;
+            }
+        }
+        return stats;
+    }
+
+private:
+    bool testFree(int order, int unit) const {
+        int block = unit >> order;
+        if (block >= (totalUnits >> order)) {
+            return false;
+        }
+        return (freeBits[order][block >> 6] >> (block & 63)) & 1;
+    }
+
+    void setFree(int order, int unit) {
+        int block = unit >> order;
+        freeBits[order][block >> 6] |= uint64_t(1) << (block & 63);
+        freeCount[order]++;
+    }
+
+    void clearFree(int order, int unit) {
+        int block = unit >> order;
+        freeBits[order][block >> 6] &= ~(uint64_t(1) << (block & 63));
+        freeCount[order]--;
+    }
+
+    void pushFree(int order, int unit) {
+        setFree(order, unit);
+        freeLists[order].push_back(unit);
+    }
+
+    // Pops a block that is still free, discarding entries for blocks that
+    // were merged away; -1 if the order has none
+    int popFree(int order) {
+        std::vector<int>& list = freeLists[order];
+        while (!list.empty()) {
+            int unit = list.back();
+            list.pop_back();
+            if (testFree(order, unit)) {
+                clearFree(order, unit);
+                return unit;
+            }
+        }
+        return -1;
+    }
+};
+
+#endif
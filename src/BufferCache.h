@@ -0,0 +1,202 @@
+#ifndef BUFFER_CACHE_H
+#define BUFFER_CACHE_H
+
+#include <set>
+#include <memory>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <unordered_set>
+#include "CacheReplacement.h"
+#include "DiskScheduler.h"
+
+struct BufferCacheConfig {
+    std::size_t capacity = 64;          // Blocks
+    int readAhead = 4;                  // Blocks prefetched on a sequential read, 0 for none
+    std::size_t writeBackBatch = 16;    // Dirty blocks that trigger a flush
+};
+
+struct BufferCacheStats {
+    long long reads = 0;
+    long long writes = 0;
+    long long readHits = 0;
+    long long writeHits = 0;
+    long long rejected = 0;             // Blocks not on the disk
+    long long diskReads = 0;            // Including prefetches
+    long long diskWrites = 0;
+    long long prefetches = 0;
+    long long prefetchHits = 0;         // Reads served by a block read ahead
+    long long flushes = 0;
+
+    long long accesses() const { return reads + writes; }
+    long long diskOperations() const { return diskReads + diskWrites; }
+
+    double hitRatio() const {
+        return accesses() > 0 ? static_cast<double>(readHits + writeHits) / accesses() : 0.0;
+    }
+
+    // Disk operations an uncached disk would have done minus those issued;
+    // negative if read-ahead fetched more than it saved
+    long long operationsSaved() const { return accesses() - diskOperations(); }
+};
+
+// Block buffer cache in front of a DiskScheduler, with blocks numbered as
+// tracks. Reads that hit are absorbed; a miss queues a disk read and, when
+// reads are sequential, reads the next few blocks ahead. Writes are
+// write-back: they only mark the block dirty, so repeated writes to one
+// block cost a single disk write. Dirty blocks are flushed as one batch
+// in track order once writeBackBatch of them accumulate, or on flush().
+// A dirty block that is evicted first stays in the write-back batch, and
+// reads of it are served from there.
+class BufferCache {
+private:
+    DiskScheduler& disk;
+    BufferCacheConfig config;
+    std::unique_ptr<CacheReplacement> policy;
+    std::set<int> dirty;                        // Sorted for the write-back batch
+    std::unordered_set<int> prefetched;         // Read ahead and not yet used
+    int lastRead;
+    int sequentialRun;
+    BufferCacheStats stats;
+
+    bool onDisk(int block) const { return block >= 0 && block < disk.getTrackCount(); }
+
+    void insert(int block) {
+        int victim = policy->insert(block);
+        if (victim >= 0) {
+            prefetched.erase(victim);
+        }
+    }
+
+    void readAhead(int block) {
+        for (int next = block + 1; next <= block + config.readAhead && onDisk(next); next++) {
+            if (!policy->contains(next) && dirty.count(next) == 0) {
+                disk.addRequest(next);
+                insert(next);
+                prefetched.insert(next);
+                stats.diskReads++;
+                stats.prefetches++;
+            }
+        }
+    }
+
+public:
+    BufferCache(DiskScheduler& _disk, BufferCacheConfig _config = BufferCacheConfig(),
+                std::unique_ptr<CacheReplacement> _policy = nullptr)
+        : disk(_disk), config(_config), policy(std::move(_policy)), lastRead(-2), sequentialRun(0) {
+        if (!policy) {
+            policy.reset(new LRUCacheReplacement());
+        }
+        policy->reset(config.capacity);
+    }
+
+    // Reads block; true on a cache hit
+    bool read(int block) {
+        if (!onDisk(block)) {
+            stats.rejected++;
+            return false;
+        }
+        stats.reads++;
+        sequentialRun = block == lastRead + 1 ? sequentialRun + 1 : 0;
+        lastRead = block;
+
+        // The first use of a read-ahead block is its first real reference,
+        // so it must not count as a reuse (ARC would promote it to T2)
+        bool hit = prefetched.count(block) != 0 ? policy->contains(block) : policy->lookup(block);
+        if (!hit && dirty.count(block) != 0) {
+            // Evicted but not yet written back
+            insert(block);
+            hit = true;
+        }
+        if (hit) {
+            stats.readHits++;
+            if (prefetched.erase(block) != 0) {
+                stats.prefetchHits++;
+            }
+        } else {
+            disk.addRequest(block);
+            insert(block);
+            stats.diskReads++;
+        }
+        if (sequentialRun > 0 && config.readAhead > 0) {
+            readAhead(block);
+        }
+        return hit;
+    }
+
+    // Writes block into the cache; true if it was already cached
+    bool write(int block) {
+        if (!onDisk(block)) {
+            stats.rejected++;
+            return false;
+        }
+        stats.writes++;
+        // As in read, a read-ahead block's first use is not a reuse
+        bool hit = (prefetched.count(block) != 0 ? policy->contains(block) : policy->lookup(block)) ||
+                   dirty.count(block) != 0;
+        if (hit) {
+            stats.writeHits++;
+        }
+        if (!policy->contains(block)) {
+            insert(block);
+        }
+        prefetched.erase(block);
+        dirty.insert(block);
+        if (dirty.size() >= config.writeBackBatch) {
+            flush();
+        }
+        return hit;
+    }
+
+    // Hands every dirty block to the disk in ascending track order and
+    // returns how many were written
+    int flush() {
+        for (int block : dirty) {
+            disk.addRequest(block);
+        }
+        int written = static_cast<int>(dirty.size());
+        stats.diskWrites += written;
+        if (written > 0) {
+            stats.flushes++;
+        }
+        dirty.clear();
+        return written;
+    }
+
+    // Flushes, then empties the cache under a new configuration and policy
+    void reconfigure(BufferCacheConfig _config, std::unique_ptr<CacheReplacement> _policy = nullptr) {
+        flush();
+        config = _config;
+        if (_policy) {
+            policy = std::move(_policy);
+        }
+        policy->reset(config.capacity);
+        prefetched.clear();
+        lastRead = -2;
+        sequentialRun = 0;
+    }
+
+    const CacheReplacement& getPolicy() const { return *policy; }
+    const BufferCacheConfig& getConfig() const { return config; }
+    std::size_t residentBlocks() const { return policy->size(); }
+    std::size_t dirtyBlocks() const { return dirty.size(); }
+
+    const BufferCacheStats& getStats() const { return stats; }
+    void resetStats() { stats = BufferCacheStats(); }
+
+    void displayStats() const {
+        std::cout << "\n=== Buffer Cache (" << policy->name() << ", " << config.capacity << " blocks) ===\n";
+        std::cout << "Reads / Writes:      " << stats.reads << " / " << stats.writes << "\n";
+        std::cout << "Resident / Dirty:    " << policy->size() << " / " << dirty.size() << "\n";
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Hit Ratio:           " << stats.hitRatio() * 100 << "%\n";
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << "Disk Reads / Writes: " << stats.diskReads << " / " << stats.diskWrites
+                  << " in " << stats.flushes << " write-back batches\n";
+        std::cout << "Read-ahead:          " << stats.prefetches << " blocks, "
+                  << stats.prefetchHits << " used\n";
+        std::cout << "Disk Ops Saved:      " << stats.operationsSaved() << "\n";
+    }
+};
+
+#endif
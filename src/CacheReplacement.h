@@ -0,0 +1,247 @@
+#ifndef CACHE_REPLACEMENT_H
+#define CACHE_REPLACEMENT_H
+
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+// Decides which blocks a BufferCache keeps. Unlike ReplacementPolicy for
+// page frames, a cache policy owns the set of resident blocks, because ARC
+// also has to remember blocks it recently evicted. Every operation is O(1)
+// amortized.
+class CacheReplacement {
+public:
+    virtual ~CacheReplacement() = default;
+
+    virtual const char* name() const = 0;
+
+    // Capacity in blocks; drops every resident block
+    virtual void reset(std::size_t capacity) = 0;
+
+    // True if block is resident; a hit also counts as a use
+    virtual bool lookup(int block) = 0;
+
+    // Makes a missing block resident and returns the block evicted to make
+    // room for it, or -1 if the cache was not full
+    virtual int insert(int block) = 0;
+
+    virtual bool contains(int block) const = 0;
+    virtual std::size_t size() const = 0;
+};
+
+class LRUCacheReplacement : public CacheReplacement {
+private:
+    std::list<int> order;                       // Most recent first
+    std::unordered_map<int, std::list<int>::iterator> where;
+    std::size_t capacity = 0;
+
+public:
+    const char* name() const override { return "LRU"; }
+
+    void reset(std::size_t _capacity) override {
+        capacity = std::max<std::size_t>(1, _capacity);
+        order.clear();
+        where.clear();
+    }
+
+    bool lookup(int block) override {
+        auto it = where.find(block);
+        if (it == where.end()) {
+            return false;
+        }
+        order.splice(order.begin(), order, it->second);
+        return true;
+    }
+
+    int insert(int block) override {
+        int victim = -1;
+        if (order.size() == capacity) {
+            victim = order.back();
+            where.erase(victim);
+            order.pop_back();
+        }
+        order.push_front(block);
+        where[block] = order.begin();
+        return victim;
+    }
+
+    bool contains(int block) const override { return where.count(block) != 0; }
+    std::size_t size() const override { return order.size(); }
+};
+
+// Second chance over a fixed ring of slots
+class ClockCacheReplacement : public CacheReplacement {
+private:
+    std::vector<int> slots;                     // Block per slot, -1 if empty
+    std::vector<uint8_t> referenced;
+    std::unordered_map<int, std::size_t> slotOf;
+    std::size_t hand = 0;
+    std::size_t used = 0;
+
+public:
+    const char* name() const override { return "CLOCK"; }
+
+    void reset(std::size_t capacity) override {
+        capacity = std::max<std::size_t>(1, capacity);
+        slots.assign(capacity, -1);
+        referenced.assign(capacity, 0);
+        slotOf.clear();
+        hand = used = 0;
+    }
+
+    bool lookup(int block) override {
+        auto it = slotOf.find(block);
+        if (it == slotOf.end()) {
+            return false;
+        }
+        referenced[it->second] = 1;
+        return true;
+    }
+
+    int insert(int block) override {
+        int victim = -1;
+        std::size_t slot;
+        if (used < slots.size()) {
+            slot = used++;
+        } else {
+            while (referenced[hand]) {
+                referenced[hand] = 0;
+                hand = (hand + 1) % slots.size();
+            }
+            slot = hand;
+            hand = (hand + 1) % slots.size();
+            victim = slots[slot];
+            slotOf.erase(victim);
+        }
+        slots[slot] = block;
+        referenced[slot] = 0;
+        slotOf[block] = slot;
+        return victim;
+    }
+
+    bool contains(int block) const override { return slotOf.count(block) != 0; }
+    std::size_t size() const override { return used; }
+};
+
+// Adaptive Replacement Cache (Megiddo and Modha). T1 holds blocks seen once
+// recently and T2 blocks seen at least twice; B1 and B2 remember blocks
+// evicted from each. A miss that hits a ghost list moves the target size p
+// of T1 towards the list that would have kept the block, so the cache tunes
+// itself between recency and frequency, and a one-off scan only churns T1.
+class ARCCacheReplacement : public CacheReplacement {
+private:
+    enum ListId { T1, T2, B1, B2 };
+
+    struct Place {
+        ListId list;
+        std::list<int>::iterator it;
+    };
+
+    std::list<int> lists[4];                    // Most recent first
+    std::unordered_map<int, Place> places;
+    std::size_t capacity = 0;
+    std::size_t target = 0;                     // p: preferred size of T1
+
+    void moveTo(int block, ListId list) {
+        Place& place = places[block];
+        lists[list].splice(lists[list].begin(), lists[place.list], place.it);
+        place.list = list;
+        place.it = lists[list].begin();
+    }
+
+    void dropLru(ListId list) {
+        places.erase(lists[list].back());
+        lists[list].pop_back();
+    }
+
+    // Evicts the LRU block of T1 or T2 into its ghost list
+    int replace(bool inB2) {
+        std::size_t t1 = lists[T1].size();
+        ListId from = t1 > 0 && ((inB2 && t1 == target) || t1 > target) ? T1 : T2;
+        if (lists[from].empty()) {
+            from = from == T1 ? T2 : T1;
+        }
+        int victim = lists[from].back();
+        moveTo(victim, from == T1 ? B1 : B2);
+        return victim;
+    }
+
+public:
+    const char* name() const override { return "ARC"; }
+
+    void reset(std::size_t _capacity) override {
+        capacity = std::max<std::size_t>(1, _capacity);
+        for (auto& list : lists) {
+            list.clear();
+        }
+        places.clear();
+        target = 0;
+    }
+
+    bool lookup(int block) override {
+        auto it = places.find(block);
+        if (it == places.end() || it->second.list == B1 || it->second.list == B2) {
+            return false;
+        }
+        moveTo(block, T2);
+        return true;
+    }
+
+    int insert(int block) override {
+        std::size_t resident = lists[T1].size() + lists[T2].size();
+        auto it = places.find(block);
+        if (it != places.end()) {
+            // Ghost hit: adapt p, make room, and promote to T2
+            bool inB1 = it->second.list == B1;
+            std::size_t b1 = lists[B1].size(), b2 = lists[B2].size();
+            if (inB1) {
+                target = std::min(capacity, target + std::max<std::size_t>(1, b2 / b1));
+            } else {
+                std::size_t step = std::max<std::size_t>(1, b1 / b2);
+                target = target > step ? target - step : 0;
+            }
+            int victim = resident >= capacity ? replace(!inB1) : -1;
+            moveTo(block, T2);
+            return victim;
+        }
+
+        int victim = -1;
+        std::size_t l1 = lists[T1].size() + lists[B1].size();
+        std::size_t total = l1 + lists[T2].size() + lists[B2].size();
+        if (l1 == capacity) {
+            if (lists[T1].size() < capacity) {
+                dropLru(B1);
+                if (resident >= capacity) {
+                    victim = replace(false);
+                }
+            } else {
+                victim = lists[T1].back();
+                dropLru(T1);
+            }
+        } else if (total >= capacity) {
+            if (total == 2 * capacity) {
+                dropLru(B2);
+            }
+            if (resident >= capacity) {
+                victim = replace(false);
+            }
+        }
+        lists[T1].push_front(block);
+        places[block] = {T1, lists[T1].begin()};
+        return victim;
+    }
+
+    bool contains(int block) const override {
+        auto it = places.find(block);
+        return it != places.end() && (it->second.list == T1 || it->second.list == T2);
+    }
+
+    std::size_t size() const override { return lists[T1].size() + lists[T2].size(); }
+
+    // Current preferred size of the recency list, for reports
+    std::size_t recencyTarget() const { return target; }
+};
+
+#endif
@@ -0,0 +1,266 @@
+#ifndef CONCURRENT_MEMORY_MANAGER_H
+#define CONCURRENT_MEMORY_MANAGER_H
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "MemoryAllocator.h"
+#include "MemoryManager.h"
+
+struct ConcurrentCacheStats {
+    long long cacheHits = 0;     // Small requests served without the lock
+    long long refills = 0;       // Batches taken from the central allocator
+    long long flushes = 0;       // Batches given back to it
+    long long centralCalls = 0;  // Requests too large for the caches
+};
+
+// Thread-safe allocator over a central backend guarded by a mutex.
+//
+// Requests up to MAX_CACHED_SIZE are rounded up to a power of two and served
+// from a per-thread magazine of free blocks of that size. A thread takes the
+// lock only to refill an empty magazine or to return half of a full one, a
+// batch at a time. A block freed by another thread goes into that thread's
+// magazine. Larger requests lock and go straight to the backend.
+//
+// Every address has a one-byte state, so a free can find a block's size
+// class and reject double frees without taking the lock. The backend must
+// not relocate blocks, so a compacting MemoryManager cannot be used.
+class ConcurrentMemoryManager : public MemoryAllocator {
+public:
+    static constexpr int CLASS_COUNT = 7;               // 1, 2, 4, ..., 64
+    static constexpr int MAX_CACHED_SIZE = 1 << (CLASS_COUNT - 1);
+
+private:
+    // Per-address state: 0 when the address does not start a cached block,
+    // otherwise the size class + 1, with LIVE set while a caller owns it
+    static constexpr uint8_t LIVE = 0x80;
+
+    struct ThreadCache {
+        std::vector<int> magazines[CLASS_COUNT];
+        ConcurrentCacheStats stats;
+    };
+
+    std::unique_ptr<MemoryAllocator> central;
+    mutable std::mutex centralMutex;
+    uint64_t instanceId;
+    int magazineSize;
+    std::vector<std::atomic<uint8_t>> state;            // [address]
+    std::vector<std::unique_ptr<ThreadCache>> caches;   // Guarded by centralMutex
+    std::unordered_map<int, int> uncachedSizes;         // Guarded by centralMutex
+    std::atomic<long long> liveBlocks;
+    std::atomic<long long> liveBytes;
+
+public:
+    ConcurrentMemoryManager(std::unique_ptr<MemoryAllocator> _central, int _magazineSize = 32)
+        : central(std::move(_central)), instanceId(nextInstanceId()++),
+          magazineSize(std::max(2, _magazineSize)),
+          state(static_cast<std::size_t>(central->getStats().totalMemory)),
+          liveBlocks(0), liveBytes(0) {
+        for (auto& s : state) {
+            s.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentMemoryManager(int totalSize = 1024)
+        : ConcurrentMemoryManager(std::unique_ptr<MemoryAllocator>(new MemoryManager(totalSize))) {}
+
+    const char* name() const override { return "Concurrent (thread caches)"; }
+
+    // Units a request of size actually holds: cached requests are rounded
+    // up to their size class
+    static int reservedSize(int size) {
+        int sizeClass = classFor(size);
+        return sizeClass < 0 ? size : 1 << sizeClass;
+    }
+
+    int allocateMemory(int size, const std::string& processName) override {
+        if (size <= 0) {
+            return -1;
+        }
+        int sizeClass = classFor(size);
+        if (sizeClass < 0) {
+            localCache().stats.centralCalls++;
+            std::lock_guard<std::mutex> lock(centralMutex);
+            int start = central->allocateMemory(size, processName);
+            if (start >= 0) {
+                uncachedSizes[start] = size;
+                liveBlocks.fetch_add(1, std::memory_order_relaxed);
+                liveBytes.fetch_add(size, std::memory_order_relaxed);
+            }
+            return start;
+        }
+
+        ThreadCache& cache = localCache();
+        std::vector<int>& magazine = cache.magazines[sizeClass];
+        if (magazine.empty()) {
+            refill(cache, sizeClass);
+            if (magazine.empty()) {
+                return -1; // Allocation failed
+            }
+        } else {
+            cache.stats.cacheHits++;
+        }
+        int start = magazine.back();
+        magazine.pop_back();
+        state[start].store(static_cast<uint8_t>((sizeClass + 1) | LIVE), std::memory_order_release);
+        liveBlocks.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_add(1 << sizeClass, std::memory_order_relaxed);
+        return start;
+    }
+
+    bool deallocateMemory(int startAddress) override {
+        if (startAddress < 0 || startAddress >= static_cast<int>(state.size())) {
+            return false;
+        }
+        uint8_t current = state[startAddress].load(std::memory_order_acquire);
+        if (current == 0) {
+            // Not a cached block: the backend decides
+            std::lock_guard<std::mutex> lock(centralMutex);
+            auto it = uncachedSizes.find(startAddress);
+            if (it == uncachedSizes.end() || !central->deallocateMemory(startAddress)) {
+                return false;
+            }
+            liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+            liveBytes.fetch_sub(it->second, std::memory_order_relaxed);
+            uncachedSizes.erase(it);
+            return true;
+        }
+
+        // Only one of several racing frees of the same block can clear LIVE
+        if (!(current & LIVE) ||
+            !state[startAddress].compare_exchange_strong(current, static_cast<uint8_t>(current & ~LIVE),
+                                                         std::memory_order_acq_rel)) {
+            return false;
+        }
+        int sizeClass = (current & ~LIVE) - 1;
+        liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(1 << sizeClass, std::memory_order_relaxed);
+
+        ThreadCache& cache = localCache();
+        std::vector<int>& magazine = cache.magazines[sizeClass];
+        magazine.push_back(startAddress);
+        if (static_cast<int>(magazine.size()) >= 2 * magazineSize) {
+            flush(cache, sizeClass, magazineSize);
+        }
+        return true;
+    }
+
+    void displayMemoryMap() override {
+        std::lock_guard<std::mutex> lock(centralMutex);
+        central->displayMemoryMap();
+
+        ConcurrentCacheStats totals = totalsLocked();
+        std::cout << "\nThread caches: " << caches.size()
+                  << "  Cache hits: " << totals.cacheHits
+                  << "  Refills: " << totals.refills
+                  << "  Flushes: " << totals.flushes
+                  << "  Uncached: " << totals.centralCalls << "\n";
+    }
+
+    // Cached free blocks count as allocated: the backend has handed them out
+    MemoryStats getStats() const override {
+        std::lock_guard<std::mutex> lock(centralMutex);
+        MemoryStats stats = central->getStats();
+        stats.allocatedBlocks = static_cast<int>(liveBlocks.load(std::memory_order_relaxed));
+        stats.requestedMemory = static_cast<int>(liveBytes.load(std::memory_order_relaxed));
+        return stats;
+    }
+
+    // Counters are updated without synchronisation by their own threads, so
+    // read them once the workers have stopped
+    ConcurrentCacheStats getCacheStats() {
+        std::lock_guard<std::mutex> lock(centralMutex);
+        return totalsLocked();
+    }
+
+    // Returns every cached block to the backend. Only safe when no other
+    // thread is using the allocator, e.g. after worker threads have joined.
+    void drainCaches() {
+        for (auto& cache : caches) {
+            for (int c = 0; c < CLASS_COUNT; c++) {
+                flush(*cache, c, static_cast<int>(cache->magazines[c].size()));
+            }
+        }
+    }
+
+private:
+    static std::atomic<uint64_t>& nextInstanceId() {
+        static std::atomic<uint64_t> id(1);
+        return id;
+    }
+
+    static int classFor(int size) {
+        int sizeClass = 0;
+        while (sizeClass < CLASS_COUNT && (1 << sizeClass) < size) {
+            sizeClass++;
+        }
+        return sizeClass < CLASS_COUNT ? sizeClass : -1;
+    }
+
+    // Magazines are only touched by their own thread; the lock is only
+    // needed the first time a thread uses this allocator
+    ThreadCache& localCache() {
+        static thread_local std::vector<std::pair<uint64_t, ThreadCache*>> owned;
+        for (const auto& entry : owned) {
+            if (entry.first == instanceId) {
+                return *entry.second;
+            }
+        }
+        std::lock_guard<std::mutex> lock(centralMutex);
+        caches.emplace_back(new ThreadCache());
+        owned.emplace_back(instanceId, caches.back().get());
+        return *caches.back();
+    }
+
+    void refill(ThreadCache& cache, int sizeClass) {
+        std::vector<int>& magazine = cache.magazines[sizeClass];
+        std::lock_guard<std::mutex> lock(centralMutex);
+        for (int i = 0; i < magazineSize; i++) {
+            int start = central->allocateMemory(1 << sizeClass, "cache");
+            if (start < 0) {
+                break;
+            }
+            state[start].store(static_cast<uint8_t>(sizeClass + 1), std::memory_order_relaxed);
+            magazine.push_back(start);
+        }
+        cache.stats.refills++;
+    }
+
+    // Returns the oldest count blocks of a magazine to the backend
+    void flush(ThreadCache& cache, int sizeClass, int count) {
+        std::vector<int>& magazine = cache.magazines[sizeClass];
+        count = std::min(count, static_cast<int>(magazine.size()));
+        if (count == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(centralMutex);
+            for (int i = 0; i < count; i++) {
+                state[magazine[i]].store(0, std::memory_order_relaxed);
+                central->deallocateMemory(magazine[i]);
+            }
+        }
+        magazine.erase(magazine.begin(), magazine.begin() + count);
+        cache.stats.flushes++;
+    }
+
+    ConcurrentCacheStats totalsLocked() const {
+        ConcurrentCacheStats totals;
+        for (const auto& cache : caches) {
+            totals.cacheHits += cache->stats.cacheHits;
+            totals.refills += cache->stats.refills;
+            totals.flushes += cache->stats.flushes;
+            totals.centralCalls += cache->stats.centralCalls;
+        }
+        return totals;
+    }
+};
+
+#endif
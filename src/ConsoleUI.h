@@ -40,8 +40,14 @@ public:
         std::cout << "1. Create New Process\n";
         std::cout << "2. Show All Processes\n";
         std::cout << "3. Run Round Robin Scheduling\n";
-        std::cout << "4. Return to Main Menu\n\n";
-        std::cout << "Enter your choice (1-4): ";
+        std::cout << "4. Compare Scheduling Policies\n";
+        std::cout << "5. Run Multi-Core Scheduling\n";
+        std::cout << "6. Replay Workload Trace\n";
+        std::cout << "7. Sweep Time Quantum\n";
+        std::cout << "8. Fork Process\n";
+        std::cout << "9. Run with Virtual Memory\n";
+        std::cout << "10. Return to Main Menu\n\n";
+        std::cout << "Enter your choice (1-10): ";
         
         int choice;
         std::cin >> choice;
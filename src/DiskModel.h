@@ -0,0 +1,119 @@
+#ifndef DISK_MODEL_H
+#define DISK_MODEL_H
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// One block request to the disk. Times are in microseconds.
+struct IORequest {
+    long long arrival;      // Earliest time the request can be issued
+    int track;
+    int sector;             // First sector on the track
+    int sectors;            // Sectors transferred
+    bool isWrite;
+    int stream;             // Issuing process or thread
+    bool dependent;         // Issued only once the stream's previous request completes
+    long long thinkTime;    // Delay after that completion before a dependent request is issued
+};
+
+// Service time of a single-head disk: seek, rotational latency, transfer.
+// Seek time grows with the square root of the distance, from a track-to-track
+// seek up to a full stroke. The platter turns continuously from time 0, so the
+// rotational latency depends on where the target sector is when the seek ends.
+struct DiskModel {
+    int tracks = 10000;
+    int sectorsPerTrack = 512;
+    int rpm = 7200;
+    double trackToTrackSeekUs = 600;
+    double fullStrokeSeekUs = 12000;
+    double settleUs = 0;            // Added to every non-zero seek
+
+    double rotationUs() const { return 60e6 / rpm; }
+
+    double seekTime(int distance) const {
+        distance = std::abs(distance);
+        if (distance == 0) {
+            return 0.0;
+        }
+        double fraction = tracks > 1 ? std::sqrt(static_cast<double>(distance - 1) / (tracks - 1)) : 0.0;
+        return settleUs + trackToTrackSeekUs + (fullStrokeSeekUs - trackToTrackSeekUs) * fraction;
+    }
+
+    // Wait at time now until sector comes under the head
+    double rotationalLatency(double now, int sector) const {
+        double period = rotationUs();
+        double under = std::fmod(now, period) / period * sectorsPerTrack;
+        double ahead = sector - under;
+        if (ahead < 0) {
+            ahead += sectorsPerTrack;
+        }
+        return ahead / sectorsPerTrack * period;
+    }
+
+    double transferTime(int sectors) const {
+        return rotationUs() * sectors / sectorsPerTrack;
+    }
+
+    // Time to serve r starting at now with the head on track head
+    double serviceTime(double now, int head, const IORequest& r) const {
+        double seek = seekTime(r.track - head);
+        return seek + rotationalLatency(now + seek, r.sector) + transferTime(r.sectors);
+    }
+};
+
+struct MixedWorkloadConfig {
+    int readers = 4;                // Streams of dependent sequential reads
+    int readsPerReader = 2000;
+    int readSectors = 8;
+    long long readerThinkUs = 100;
+    int writers = 1;                // Streams of independent random writes
+    double writesPerSecond = 20;    // Per writer
+    int writeSectors = 64;
+    unsigned seed = 1;
+};
+
+// Readers walk forward through their own file, a few sectors per request,
+// issuing the next read only after the last one returns. Writers issue
+// independent writes at random places as a Poisson process, as a write-back
+// daemon would, until the readers finish.
+inline std::vector<IORequest> generateMixedWorkload(const DiskModel& disk, const MixedWorkloadConfig& config) {
+    std::vector<IORequest> requests;
+    std::mt19937 rng(config.seed);
+    std::uniform_int_distribution<int> anyTrack(0, disk.tracks - 1);
+    std::uniform_int_distribution<int> anySector(0, disk.sectorsPerTrack - 1);
+
+    for (int reader = 0; reader < config.readers; reader++) {
+        int track = anyTrack(rng);
+        int sector = anySector(rng);
+        for (int i = 0; i < config.readsPerReader; i++) {
+            requests.push_back({0, track, sector, config.readSectors, false, reader, i > 0, config.readerThinkUs});
+            sector += config.readSectors;
+            if (sector >= disk.sectorsPerTrack) {
+                sector -= disk.sectorsPerTrack;
+                track = std::min(track + 1, disk.tracks - 1);
+            }
+        }
+    }
+
+    // Rough time the disk needs for the reads alone, about a turn per read
+    long long readSpan = static_cast<long long>(config.readers) * config.readsPerReader *
+                         (config.readerThinkUs + static_cast<long long>(disk.rotationUs()));
+
+    if (config.writesPerSecond > 0) {
+        std::exponential_distribution<double> gap(config.writesPerSecond / 1e6);
+        for (int writer = 0; writer < config.writers; writer++) {
+            double at = gap(rng);
+            while (at < readSpan) {
+                requests.push_back({static_cast<long long>(at), anyTrack(rng), anySector(rng),
+                                    config.writeSectors, true, config.readers + writer, false, 0});
+                at += gap(rng);
+            }
+        }
+    }
+    return requests;
+}
+
+#endif
@@ -2,45 +2,190 @@
 #define DISK_SCHEDULER_H
 
 #include <vector>
+#include <map>
 #include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
 
+enum class DiskPolicy { SSTF, SCAN, C_SCAN, LOOK, C_LOOK };
+
+inline const char* diskPolicyName(DiskPolicy policy) {
+    switch (policy) {
+        case DiskPolicy::SSTF: return "SSTF";
+        case DiskPolicy::SCAN: return "SCAN";
+        case DiskPolicy::C_SCAN: return "C-SCAN";
+        case DiskPolicy::LOOK: return "LOOK";
+        case DiskPolicy::C_LOOK: return "C-LOOK";
+    }
+    return "?";
+}
+
+struct DiskStats {
+    long long admitted = 0;
+    long long rejected = 0;         // Outside the disk
+    long long serviced = 0;
+    long long headMovement = 0;     // Tracks travelled, including edge runs and returns
+    long long reversals = 0;
+
+    double averageSeek() const {
+        return serviced > 0 ? static_cast<double>(headMovement) / serviced : 0.0;
+    }
+};
+
+// Online disk scheduler. Pending requests are kept per track in an ordered
+// map, so requests can be admitted at any time and each next request is
+// found with one or two O(log n) lookups from the head position.
+//
+//   SSTF    nearest pending track in either direction
+//   SCAN    sweeps to the disk edge, then reverses
+//   C-SCAN  sweeps to the edge, returns to the other edge, sweeps again
+//   LOOK    as SCAN, but reverses at the last pending request
+//   C-LOOK  as C-SCAN, but returns only as far as the first pending request
+//
+// The circular policies sweep in the direction set with setDirection.
 class DiskScheduler {
 private:
     int currentPosition;
-    std::vector<int> queue;
+    int trackCount;
+    DiskPolicy policy;
+    bool movingUp;
+    std::map<int, int> pending;     // Track -> pending requests on it
+    long long pendingCount;
+    DiskStats stats;
 
-public:
-    DiskScheduler(int startPosition = 0) : currentPosition(startPosition) {}
+    // Nearest pending track at or beyond the head in the given direction
+    std::map<int, int>::iterator ahead(bool up) {
+        if (up) {
+            return pending.lower_bound(currentPosition);
+        }
+        auto it = pending.upper_bound(currentPosition);
+        return it == pending.begin() ? pending.end() : std::prev(it);
+    }
 
-    void addRequest(int position) {
-        queue.push_back(position);
+    void moveTo(int track) {
+        stats.headMovement += std::abs(track - currentPosition);
+        currentPosition = track;
     }
 
-    // SCAN (Elevator) Algorithm
-    std::vector<int> executeSCAN(bool direction = true) {
-        std::vector<int> sequence;
-        std::vector<int> greater, lesser;
+    void reverse() {
+        movingUp = !movingUp;
+        stats.reversals++;
+    }
 
-        for (int pos : queue) {
-            if (pos >= currentPosition)
-                greater.push_back(pos);
-            else
-                lesser.push_back(pos);
+    std::map<int, int>::iterator select() {
+        int edge = movingUp ? trackCount - 1 : 0;
+        int otherEdge = movingUp ? 0 : trackCount - 1;
+        auto it = ahead(movingUp);
+        if (it != pending.end()) {
+            if (policy != DiskPolicy::SSTF) {
+                return it;
+            }
+            auto behind = ahead(!movingUp);
+            if (behind != pending.end() &&
+                std::abs(behind->first - currentPosition) < std::abs(it->first - currentPosition)) {
+                reverse();
+                return behind;
+            }
+            return it;
         }
 
-        std::sort(greater.begin(), greater.end());
-        std::sort(lesser.begin(), lesser.end());
+        // Nothing left in this direction
+        switch (policy) {
+            case DiskPolicy::SSTF:
+            case DiskPolicy::LOOK:
+                reverse();
+                return ahead(movingUp);
+            case DiskPolicy::SCAN:
+                moveTo(edge);
+                reverse();
+                return ahead(movingUp);
+            case DiskPolicy::C_SCAN:
+                moveTo(edge);
+                moveTo(otherEdge);
+                return ahead(movingUp);
+            case DiskPolicy::C_LOOK:
+                moveTo(movingUp ? pending.begin()->first : std::prev(pending.end())->first);
+                return ahead(movingUp);
+        }
+        return pending.end();
+    }
+
+public:
+    static constexpr int DEFAULT_TRACKS = 200;
 
-        if (direction) {  // Moving towards higher track numbers
-            sequence.insert(sequence.end(), greater.begin(), greater.end());
-            sequence.insert(sequence.end(), lesser.rbegin(), lesser.rend());
-        } else {  // Moving towards lower track numbers
-            sequence.insert(sequence.end(), lesser.rbegin(), lesser.rend());
-            sequence.insert(sequence.end(), greater.begin(), greater.end());
+    DiskScheduler(int startPosition = 0, int tracks = DEFAULT_TRACKS, DiskPolicy _policy = DiskPolicy::SCAN)
+        : currentPosition(std::max(0, std::min(startPosition, tracks - 1))), trackCount(tracks), policy(_policy),
+          movingUp(true), pendingCount(0) {}
+
+    // Queues a request for track; false if the track is not on the disk
+    bool addRequest(int track) {
+        if (track < 0 || track >= trackCount) {
+            stats.rejected++;
+            return false;
+        }
+        pending[track]++;
+        pendingCount++;
+        stats.admitted++;
+        return true;
+    }
+
+    // Moves the head to the next request and returns its track, or -1 if
+    // nothing is pending
+    int serviceNext() {
+        if (pendingCount == 0) {
+            return -1;
         }
+        auto it = select();
+        int track = it->first;
+        moveTo(track);
+        if (--it->second == 0) {
+            pending.erase(it);
+        }
+        pendingCount--;
+        stats.serviced++;
+        return track;
+    }
 
+    // Services every pending request, returning tracks in service order
+    std::vector<int> serviceAll() {
+        std::vector<int> sequence;
+        sequence.reserve(static_cast<std::size_t>(pendingCount));
+        while (pendingCount > 0) {
+            sequence.push_back(serviceNext());
+        }
         return sequence;
     }
+
+    void setPolicy(DiskPolicy _policy) { policy = _policy; }
+    DiskPolicy getPolicy() const { return policy; }
+
+    // true sweeps towards higher track numbers
+    void setDirection(bool up) { movingUp = up; }
+    bool isMovingUp() const { return movingUp; }
+
+    int getPosition() const { return currentPosition; }
+    int getTrackCount() const { return trackCount; }
+    long long pendingRequests() const { return pendingCount; }
+
+    const DiskStats& getStats() const { return stats; }
+    void resetStats() { stats = DiskStats(); }
+
+    void displayStats() const {
+        std::cout << "\n=== Disk Statistics (" << diskPolicyName(policy) << ") ===\n";
+        std::cout << "Head Position:      " << currentPosition << " of " << trackCount << " tracks\n";
+        std::cout << "Pending Requests:   " << pendingCount << "\n";
+        std::cout << "Serviced Requests:  " << stats.serviced << "\n";
+        if (stats.rejected > 0) {
+            std::cout << "Rejected Requests:  " << stats.rejected << "\n";
+        }
+        std::cout << "Head Movement:      " << stats.headMovement << " tracks\n";
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Average Seek:       " << stats.averageSeek() << " tracks\n";
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << "Direction Changes:  " << stats.reversals << "\n";
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
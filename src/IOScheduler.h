@@ -0,0 +1,168 @@
+#ifndef IO_SCHEDULER_H
+#define IO_SCHEDULER_H
+
+#include <vector>
+#include <queue>
+#include <string>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <unordered_map>
+#include "DiskModel.h"
+#include "IOSchedulingPolicies.h"
+#include "SchedulingMetrics.h"
+
+struct IOReport {
+    std::string policy;
+    long long reads = 0;
+    long long writes = 0;
+    double makespanUs = 0.0;
+    double busyUs = 0.0;
+    double seekUs = 0.0;
+    long long headMovement = 0;
+    LatencyHistogram readLatency;       // Microseconds from issue to completion
+    LatencyHistogram writeLatency;
+
+    long long requests() const { return reads + writes; }
+    double iops() const { return makespanUs > 0 ? requests() * 1e6 / makespanUs : 0.0; }
+    double utilization() const { return makespanUs > 0 ? busyUs / makespanUs : 0.0; }
+};
+
+// Event-driven simulation of one disk serving timed requests through an
+// I/O scheduling policy. Independent requests are issued at their arrival
+// time; a dependent request is issued thinkTime after its stream's previous
+// request completes. The disk serves one request at a time, and the policy
+// is asked for the next one each time it goes idle.
+class IOSimulator {
+private:
+    DiskModel disk;
+    int startTrack;
+
+public:
+    IOSimulator(DiskModel _disk = DiskModel(), int _startTrack = 0)
+        : disk(_disk), startTrack(_startTrack) {}
+
+    const DiskModel& getDisk() const { return disk; }
+
+    template <typename Policy>
+    IOReport run(const std::vector<IORequest>& requests, Policy& policy) const {
+        IOReport report;
+        report.policy = policy.name();
+        int n = static_cast<int>(requests.size());
+        policy.reset(requests.size());
+
+        // Successor of each request in its stream, for dependent issue
+        std::vector<int> successor(n, -1);
+        std::unordered_map<int, int> lastOfStream;
+        for (int i = 0; i < n; i++) {
+            auto last = lastOfStream.find(requests[i].stream);
+            if (last != lastOfStream.end()) {
+                successor[last->second] = i;
+            }
+            lastOfStream[requests[i].stream] = i;
+        }
+
+        // Issue times of requests not yet handed to the policy
+        typedef std::pair<double, int> Issue;
+        std::priority_queue<Issue, std::vector<Issue>, std::greater<Issue>> issues;
+        std::vector<uint8_t> hasPredecessor(n, 0);
+        for (int i = 0; i < n; i++) {
+            if (successor[i] >= 0) {
+                hasPredecessor[successor[i]] = 1;
+            }
+        }
+        for (int i = 0; i < n; i++) {
+            if (!requests[i].dependent || !hasPredecessor[i]) {
+                issues.emplace(static_cast<double>(requests[i].arrival), i);
+            }
+        }
+
+        std::vector<double> issuedAt(n, 0.0);
+        double now = 0.0;
+        int head = startTrack;
+        int done = 0;
+        while (done < n) {
+            while (!issues.empty() && issues.top().first <= now) {
+                int index = issues.top().second;
+                issuedAt[index] = issues.top().first;
+                issues.pop();
+                policy.admit(index, requests[index], static_cast<long long>(issuedAt[index]));
+            }
+            if (policy.empty()) {
+                if (issues.empty()) {
+                    break;
+                }
+                now = issues.top().first;
+                continue;
+            }
+
+            long long waitUntil = 0;
+            int index = policy.pickNext(head, static_cast<long long>(now), waitUntil);
+            if (index < 0) {
+                double wake = static_cast<double>(waitUntil);
+                now = issues.empty() ? wake : std::min(wake, issues.top().first);
+                continue;
+            }
+
+            const IORequest& r = requests[index];
+            double seek = disk.seekTime(r.track - head);
+            double service = disk.serviceTime(now, head, r);
+            report.headMovement += std::abs(r.track - head);
+            report.seekUs += seek;
+            report.busyUs += service;
+            head = r.track;
+            now += service;
+            done++;
+
+            long long latency = std::llround(now - issuedAt[index]);
+            if (r.isWrite) {
+                report.writes++;
+                report.writeLatency.record(latency);
+            } else {
+                report.reads++;
+                report.readLatency.record(latency);
+            }
+            policy.completed(index, r, static_cast<long long>(now));
+
+            int next = successor[index];
+            if (next >= 0 && requests[next].dependent) {
+                issues.emplace(std::max(static_cast<double>(requests[next].arrival), now + r.thinkTime), next);
+            }
+        }
+        report.makespanUs = now;
+        return report;
+    }
+
+    static void displayReports(const std::vector<IOReport>& reports) {
+        std::cout << std::left
+                  << std::setw(14) << "Policy"
+                  << std::setw(8) << "IOPS"
+                  << std::setw(7) << "Util"
+                  << std::setw(10) << "Read p50"
+                  << std::setw(10) << "Read p99"
+                  << std::setw(11) << "Read p999"
+                  << std::setw(11) << "Write p50"
+                  << std::setw(11) << "Write p99"
+                  << "Avg Seek\n";
+        std::cout << std::string(90, '-') << "\n";
+        for (const IOReport& report : reports) {
+            auto ms = [](long long us) { return us / 1000.0; };
+            std::cout << std::left << std::fixed << std::setprecision(1)
+                      << std::setw(14) << report.policy
+                      << std::setw(8) << report.iops()
+                      << std::setw(7) << report.utilization() * 100
+                      << std::setprecision(2)
+                      << std::setw(10) << ms(report.readLatency.percentile(0.50))
+                      << std::setw(10) << ms(report.readLatency.percentile(0.99))
+                      << std::setw(11) << ms(report.readLatency.percentile(0.999))
+                      << std::setw(11) << ms(report.writeLatency.percentile(0.50))
+                      << std::setw(11) << ms(report.writeLatency.percentile(0.99))
+                      << (report.requests() > 0 ? report.seekUs / 1000.0 / report.requests() : 0.0) << "\n";
+        }
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << "Latencies and average seek in ms; utilization in %\n";
+    }
+};
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef IO_SCHEDULING_POLICIES_H
+#define IO_SCHEDULING_POLICIES_H
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "DiskModel.h"
+
+// I/O scheduling policies plugged into IOSimulator::run<Policy>().
+//
+// Like the CPU policies in SchedulingPolicies.h, each is a plain class
+// dispatched at compile time that provides:
+//   const char* name() const
+//   void reset(std::size_t requestCount)
+//   void admit(int index, const IORequest& r, long long now)
+//   bool empty() const
+//   int  pickNext(int head, long long now, long long& waitUntil)
+//   void completed(int index, const IORequest& r, long long now)
+//
+// pickNext() removes and returns a request index, or returns -1 to keep the
+// disk idle until waitUntil or the next arrival, whichever comes first.
+
+// Pending requests ordered by track, with O(log n) removal of any request.
+// Requests on the same track keep their arrival order.
+class SortedRequests {
+private:
+    std::multimap<int, int> byTrack;
+    std::vector<std::multimap<int, int>::iterator> where;
+    std::vector<uint8_t> queued;
+
+public:
+    void reset(std::size_t requestCount) {
+        byTrack.clear();
+        where.assign(requestCount, byTrack.end());
+        queued.assign(requestCount, 0);
+    }
+
+    void insert(int index, int track) {
+        where[index] = byTrack.emplace(track, index);
+        queued[index] = 1;
+    }
+
+    void erase(int index) {
+        byTrack.erase(where[index]);
+        queued[index] = 0;
+    }
+
+    bool contains(int index) const { return queued[index] != 0; }
+    bool empty() const { return byTrack.empty(); }
+    std::size_t size() const { return byTrack.size(); }
+
+    // First request on track or above, -1 if none
+    int atOrAfter(int track) const {
+        auto it = byTrack.lower_bound(track);
+        return it == byTrack.end() ? -1 : it->second;
+    }
+
+    // Last request on track or below, -1 if none
+    int atOrBefore(int track) const {
+        auto it = byTrack.upper_bound(track);
+        return it == byTrack.begin() ? -1 : std::prev(it)->second;
+    }
+
+    int lowest() const { return byTrack.empty() ? -1 : byTrack.begin()->second; }
+};
+
+class FCFSIOPolicy {
+private:
+    std::deque<int> pending;
+
+public:
+    const char* name() const { return "FCFS"; }
+
+    void reset(std::size_t) { pending.clear(); }
+
+    void admit(int index, const IORequest&, long long) { pending.push_back(index); }
+
+    bool empty() const { return pending.empty(); }
+
+    int pickNext(int, long long, long long&) {
+        int index = pending.front();
+        pending.pop_front();
+        return index;
+    }
+
+    void completed(int, const IORequest&, long long) {}
+};
+
+// LOOK elevator: serves the nearest request in the sweep direction and
+// reverses at the last one. Minimises seeking but ignores waiting time.
+class LookIOPolicy {
+private:
+    SortedRequests sorted;
+    bool movingUp = true;
+
+public:
+    const char* name() const { return "LOOK"; }
+
+    void reset(std::size_t requestCount) {
+        sorted.reset(requestCount);
+        movingUp = true;
+    }
+
+    void admit(int index, const IORequest& r, long long) { sorted.insert(index, r.track); }
+
+    bool empty() const { return sorted.empty(); }
+
+    int pickNext(int head, long long, long long&) {
+        int index = movingUp ? sorted.atOrAfter(head) : sorted.atOrBefore(head);
+        if (index < 0) {
+            movingUp = !movingUp;
+            index = movingUp ? sorted.atOrAfter(head) : sorted.atOrBefore(head);
+        }
+        sorted.erase(index);
+        return index;
+    }
+
+    void completed(int, const IORequest&, long long) {}
+};
+
+// Deadline scheduler, after the Linux one. Reads and writes each have a
+// track-sorted queue and a FIFO with an expiry time. Requests go out in
+// batches of up to fifoBatch in ascending track order from the head. At
+// each new batch reads are preferred, unless writes have been passed over
+// writesStarved times, and an expired request at the head of the chosen
+// FIFO is served first.
+class DeadlineIOPolicy {
+private:
+    static constexpr int READ = 0;
+    static constexpr int WRITE = 1;
+
+    SortedRequests sorted[2];
+    std::deque<int> fifo[2];            // Arrival order; served entries are skipped lazily
+    std::vector<long long> deadline;
+    long long expire[2];
+    int fifoBatch;
+    int writesStarved;
+    int batchDirection;
+    int batchRemaining;
+    int starved;
+
+    void dropServed(int direction) {
+        while (!fifo[direction].empty() && !sorted[direction].contains(fifo[direction].front())) {
+            fifo[direction].pop_front();
+        }
+    }
+
+    bool expired(int direction, long long now) {
+        dropServed(direction);
+        return !fifo[direction].empty() && deadline[fifo[direction].front()] <= now;
+    }
+
+public:
+    DeadlineIOPolicy(long long readExpireUs = 500000, long long writeExpireUs = 5000000,
+                     int _fifoBatch = 16, int _writesStarved = 2)
+        : expire{readExpireUs, writeExpireUs}, fifoBatch(_fifoBatch), writesStarved(_writesStarved),
+          batchDirection(READ), batchRemaining(0), starved(0) {}
+
+    const char* name() const { return "Deadline"; }
+
+    void reset(std::size_t requestCount) {
+        for (int direction : {READ, WRITE}) {
+            sorted[direction].reset(requestCount);
+            fifo[direction].clear();
+        }
+        deadline.assign(requestCount, 0);
+        batchRemaining = starved = 0;
+    }
+
+    void admit(int index, const IORequest& r, long long now) {
+        int direction = r.isWrite ? WRITE : READ;
+        sorted[direction].insert(index, r.track);
+        fifo[direction].push_back(index);
+        deadline[index] = now + expire[direction];
+    }
+
+    bool empty() const { return sorted[READ].empty() && sorted[WRITE].empty(); }
+
+    bool isQueued(int index) const { return sorted[READ].contains(index) || sorted[WRITE].contains(index); }
+
+    // True if the oldest read or write has passed its deadline
+    bool anyExpired(long long now) { return expired(READ, now) || expired(WRITE, now); }
+
+    // Removes a specific queued request, for policies built on this one
+    void take(int index) {
+        sorted[sorted[READ].contains(index) ? READ : WRITE].erase(index);
+        if (batchRemaining > 0) {
+            batchRemaining--;
+        }
+    }
+
+    int pickNext(int head, long long now, long long&) {
+        if (batchRemaining > 0) {
+            int index = sorted[batchDirection].atOrAfter(head);
+            if (index >= 0) {
+                take(index);
+                return index;
+            }
+        }
+
+        bool reads = !sorted[READ].empty();
+        bool writes = !sorted[WRITE].empty();
+        if (reads && (!writes || starved < writesStarved)) {
+            batchDirection = READ;
+            if (writes) {
+                starved++;
+            }
+        } else {
+            batchDirection = WRITE;
+            starved = 0;
+        }
+
+        int index;
+        if (expired(batchDirection, now)) {
+            index = fifo[batchDirection].front();
+        } else {
+            index = sorted[batchDirection].atOrAfter(head);
+            if (index < 0) {
+                index = sorted[batchDirection].lowest();
+            }
+        }
+        batchRemaining = fifoBatch;
+        take(index);
+        return index;
+    }
+
+    void completed(int, const IORequest&, long long) {}
+};
+
+// Anticipatory scheduler: Deadline, plus a short idle wait after each read.
+// A process reading a file sequentially issues its next read only after the
+// last one returns; serving someone else's request in that gap costs two
+// long seeks. After a read completes, the disk waits up to anticipationUs
+// for the same stream to issue again, as long as that stream's mean think
+// time says it is likely to, and no deadline has expired.
+class AnticipatoryIOPolicy {
+private:
+    struct Stream {
+        std::deque<int> pending;
+        double meanThink = 0.0;
+        long long lastCompletion = -1;
+    };
+
+    DeadlineIOPolicy deadline;
+    std::unordered_map<int, Stream> streams;
+    long long anticipationUs;
+    int anticipatedStream;
+    long long anticipateUntil;
+    long long waits;
+    long long hits;
+
+public:
+    // Reads expire sooner than under plain Deadline, as in the Linux
+    // anticipatory scheduler, so one stream cannot hold the disk for long
+    AnticipatoryIOPolicy(long long _anticipationUs = 6000, DeadlineIOPolicy _deadline = DeadlineIOPolicy(125000))
+        : deadline(_deadline), anticipationUs(_anticipationUs), anticipatedStream(-1),
+          anticipateUntil(0), waits(0), hits(0) {}
+
+    const char* name() const { return "Anticipatory"; }
+
+    void reset(std::size_t requestCount) {
+        deadline.reset(requestCount);
+        streams.clear();
+        anticipatedStream = -1;
+        waits = hits = 0;
+    }
+
+    void admit(int index, const IORequest& r, long long now) {
+        deadline.admit(index, r, now);
+        Stream& stream = streams[r.stream];
+        stream.pending.push_back(index);
+        if (stream.lastCompletion >= 0) {
+            double think = static_cast<double>(now - stream.lastCompletion);
+            stream.meanThink = 0.75 * stream.meanThink + 0.25 * think;
+        }
+    }
+
+    bool empty() const { return deadline.empty(); }
+
+    int pickNext(int head, long long now, long long& waitUntil) {
+        if (anticipatedStream >= 0) {
+            Stream& stream = streams[anticipatedStream];
+            while (!stream.pending.empty() && !deadline.isQueued(stream.pending.front())) {
+                stream.pending.pop_front();
+            }
+            if (!stream.pending.empty() && !deadline.anyExpired(now)) {
+                int index = stream.pending.front();
+                deadline.take(index);
+                anticipatedStream = -1;
+                hits++;
+                return index;
+            }
+            if (now < anticipateUntil && !deadline.anyExpired(now)) {
+                waitUntil = anticipateUntil;
+                return -1;
+            }
+            anticipatedStream = -1;
+        }
+        return deadline.pickNext(head, now, waitUntil);
+    }
+
+    void completed(int, const IORequest& r, long long now) {
+        Stream& stream = streams[r.stream];
+        stream.lastCompletion = now;
+        if (!r.isWrite && stream.meanThink < anticipationUs) {
+            anticipatedStream = r.stream;
+            anticipateUntil = now + anticipationUs;
+            waits++;
+        }
+    }
+
+    long long getAnticipations() const { return waits; }
+    long long getAnticipationHits() const { return hits; }
+};
+
+#endif
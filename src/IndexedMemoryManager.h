@@ -0,0 +1,417 @@
+#ifndef INDEXED_MEMORY_MANAGER_H
+#define INDEXED_MEMORY_MANAGER_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <climits>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "MemoryAllocator.h"
+
+enum class FitStrategy {
+    FIRST_FIT,
+    BEST_FIT,
+    WORST_FIT,
+    NEXT_FIT
+};
+
+// Free blocks ordered by start address. Each node also stores the largest
+// block size in its subtree, so "lowest address with size >= n" is answered
+// in O(log n) by skipping subtrees that are too small. Implemented as a
+// treap whose nodes live in one pooled vector.
+class FreeBlockTree {
+private:
+    static constexpr int NIL = -1;
+
+    struct Node {
+        int start;
+        int size;
+        int maxSize;        // Largest size in this subtree
+        uint32_t priority;
+        int left;
+        int right;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    std::vector<int> path;      // Scratch space for reshape()
+    int root;
+    int count;
+    uint32_t seed;
+
+    uint32_t nextPriority() {
+        // xorshift32: deterministic and cheap
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    int maxOf(int t) const { return t == NIL ? 0 : nodes[t].maxSize; }
+
+    void update(int t) {
+        nodes[t].maxSize = std::max(nodes[t].size, std::max(maxOf(nodes[t].left), maxOf(nodes[t].right)));
+    }
+
+    // Splits t into keys < start and keys >= start
+    void split(int t, int start, int& less, int& rest) {
+        if (t == NIL) {
+            less = rest = NIL;
+        } else if (nodes[t].start < start) {
+            split(nodes[t].right, start, nodes[t].right, rest);
+            less = t;
+            update(t);
+        } else {
+            split(nodes[t].left, start, less, nodes[t].left);
+            rest = t;
+            update(t);
+        }
+    }
+
+    int merge(int a, int b) {
+        if (a == NIL) return b;
+        if (b == NIL) return a;
+        if (nodes[a].priority > nodes[b].priority) {
+            nodes[a].right = merge(nodes[a].right, b);
+            update(a);
+            return a;
+        }
+        nodes[b].left = merge(a, nodes[b].left);
+        update(b);
+        return b;
+    }
+
+    int firstFit(int t, int from, int size) const {
+        while (t != NIL && nodes[t].maxSize >= size) {
+            const Node& n = nodes[t];
+            if (n.start < from) {
+                t = n.right;
+                continue;
+            }
+            int found = firstFit(n.left, from, size);
+            if (found != NIL) {
+                return found;
+            }
+            if (n.size >= size) {
+                return t;
+            }
+            t = n.right;
+        }
+        return NIL;
+    }
+
+    template <typename Visit>
+    void inorder(int t, Visit& visit) const {
+        if (t == NIL) return;
+        inorder(nodes[t].left, visit);
+        visit(nodes[t].start, nodes[t].size);
+        inorder(nodes[t].right, visit);
+    }
+
+public:
+    FreeBlockTree() : root(NIL), count(0), seed(2463534242u) {}
+
+    int size() const { return count; }
+    int largest() const { return maxOf(root); }
+
+    void insert(int start, int size) {
+        int t;
+        if (!freeNodes.empty()) {
+            t = freeNodes.back();
+            freeNodes.pop_back();
+        } else {
+            t = static_cast<int>(nodes.size());
+            nodes.push_back({});
+        }
+        nodes[t] = {start, size, size, nextPriority(), NIL, NIL};
+
+        int less, rest;
+        split(root, start, less, rest);
+        root = merge(merge(less, t), rest);
+        count++;
+    }
+
+    // Removes the block starting exactly at start
+    bool erase(int start) {
+        int less, rest, match, greater;
+        split(root, start, less, rest);
+        split(rest, start + 1, match, greater);
+        root = merge(less, greater);
+        if (match == NIL) {
+            return false;
+        }
+        freeNodes.push_back(match);
+        count--;
+        return true;
+    }
+
+    // Moves and resizes the block at start in place. The caller guarantees
+    // the new start keeps address order, so the tree shape is unchanged and
+    // only the subtree maxima on the search path are refreshed.
+    bool reshape(int start, int newStart, int newSize) {
+        path.clear();
+        int t = root;
+        while (t != NIL && nodes[t].start != start) {
+            path.push_back(t);
+            t = start < nodes[t].start ? nodes[t].left : nodes[t].right;
+        }
+        if (t == NIL) {
+            return false;
+        }
+        nodes[t].start = newStart;
+        nodes[t].size = newSize;
+        update(t);
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            update(*it);
+        }
+        return true;
+    }
+
+    // Block with the largest start below address; false if none
+    bool predecessor(int address, int& start, int& size) const {
+        bool found = false;
+        for (int t = root; t != NIL;) {
+            if (nodes[t].start < address) {
+                start = nodes[t].start;
+                size = nodes[t].size;
+                found = true;
+                t = nodes[t].right;
+            } else {
+                t = nodes[t].left;
+            }
+        }
+        return found;
+    }
+
+    // Block starting exactly at address; false if none
+    bool find(int address, int& size) const {
+        for (int t = root; t != NIL;) {
+            if (nodes[t].start == address) {
+                size = nodes[t].size;
+                return true;
+            }
+            t = address < nodes[t].start ? nodes[t].left : nodes[t].right;
+        }
+        return false;
+    }
+
+    // Lowest-addressed block at or after from that holds size; -1 if none
+    int firstFit(int from, int size) const {
+        int t = firstFit(root, from, size);
+        return t == NIL ? -1 : nodes[t].start;
+    }
+
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        inorder(root, visit);
+    }
+
+    void clear() {
+        nodes.clear();
+        freeNodes.clear();
+        root = NIL;
+        count = 0;
+    }
+};
+
+// Allocator with indexed free blocks: allocated blocks are kept in an
+// address-ordered map, free blocks in an address-ordered FreeBlockTree and,
+// for best fit, in a (size, start) ordered set. Allocation under every fit
+// strategy, deallocation and coalescing with both neighbours are O(log n).
+class IndexedMemoryManager : public MemoryAllocator {
+private:
+    struct AllocatedBlock {
+        int size;
+        std::string processName;
+    };
+
+    int totalMemorySize;
+    FitStrategy strategy;
+    std::map<int, AllocatedBlock> allocatedBlocks;     // start -> block
+    FreeBlockTree freeByAddress;
+    std::set<std::pair<int, int>> freeBySize;          // (size, start)
+    int allocatedMemory;
+    int nextFitCursor;
+
+public:
+    IndexedMemoryManager(int totalSize = 1024, FitStrategy _strategy = FitStrategy::FIRST_FIT)
+        : totalMemorySize(totalSize), strategy(_strategy), allocatedMemory(0), nextFitCursor(0) {
+        addFree(0, totalSize);
+    }
+
+    const char* name() const override {
+        switch (strategy) {
+        case FitStrategy::FIRST_FIT: return "First Fit (indexed)";
+        case FitStrategy::BEST_FIT:  return "Best Fit (indexed)";
+        case FitStrategy::WORST_FIT: return "Worst Fit (indexed)";
+        case FitStrategy::NEXT_FIT:  return "Next Fit (indexed)";
+        }
+        return "Indexed";
+    }
+
+    FitStrategy getStrategy() const { return strategy; }
+
+    int allocateMemory(int size, const std::string& processName) override {
+        if (size <= 0) {
+            return -1;
+        }
+
+        int start = findFree(size);
+        if (start < 0) {
+            return -1; // Allocation failed
+        }
+
+        int blockSize = 0;
+        freeByAddress.find(start, blockSize);
+        unindexSize(blockSize, start);
+        if (blockSize > size) {
+            // The remainder keeps the block's place in address order
+            freeByAddress.reshape(start, start + size, blockSize - size);
+            indexSize(blockSize - size, start + size);
+        } else {
+            freeByAddress.erase(start);
+        }
+
+        allocatedBlocks.emplace(start, AllocatedBlock{size, processName});
+        allocatedMemory += size;
+        nextFitCursor = start + size;
+        return start;
+    }
+
+    bool deallocateMemory(int startAddress) override {
+        auto it = allocatedBlocks.find(startAddress);
+        if (it == allocatedBlocks.end()) {
+            return false;
+        }
+
+        int start = startAddress;
+        int size = it->second.size;
+        allocatedMemory -= size;
+        allocatedBlocks.erase(it);
+
+        // Coalesce with the free neighbours on either side, growing an
+        // existing node in place where possible
+        int prevStart = 0, prevSize = 0, nextSize = 0;
+        bool mergePrev = freeByAddress.predecessor(start, prevStart, prevSize) &&
+                         prevStart + prevSize == start;
+        bool mergeNext = freeByAddress.find(start + size, nextSize);
+
+        if (mergePrev && mergeNext) {
+            removeFree(start + size, nextSize);
+            unindexSize(prevSize, prevStart);
+            freeByAddress.reshape(prevStart, prevStart, prevSize + size + nextSize);
+            indexSize(prevSize + size + nextSize, prevStart);
+        } else if (mergePrev) {
+            unindexSize(prevSize, prevStart);
+            freeByAddress.reshape(prevStart, prevStart, prevSize + size);
+            indexSize(prevSize + size, prevStart);
+        } else if (mergeNext) {
+            unindexSize(nextSize, start + size);
+            freeByAddress.reshape(start + size, start, size + nextSize);
+            indexSize(size + nextSize, start);
+        } else {
+            addFree(start, size);
+        }
+        return true;
+    }
+
+    void displayMemoryMap() override {
+        std::cout << "\n=== Memory Map (" << name() << ") ===\n";
+        std::cout << std::left
+                  << std::setw(10) << "Start"
+                  << std::setw(10) << "Size"
+                  << std::setw(15) << "Status"
+                  << "Process\n";
+        std::cout << "---------------------------------------------\n";
+
+        // Merge the two address-ordered indexes
+        std::vector<std::pair<int, int>> freeBlocks;
+        freeByAddress.forEach([&](int start, int size) { freeBlocks.emplace_back(start, size); });
+        auto freeIt = freeBlocks.begin();
+        auto allocIt = allocatedBlocks.begin();
+        while (freeIt != freeBlocks.end() || allocIt != allocatedBlocks.end()) {
+            bool takeFree = allocIt == allocatedBlocks.end() ||
+                            (freeIt != freeBlocks.end() && freeIt->first < allocIt->first);
+            if (takeFree) {
+                std::cout << std::left
+                          << std::setw(10) << freeIt->first
+                          << std::setw(10) << freeIt->second
+                          << std::setw(15) << "Free" << "N/A\n";
+                ++freeIt;
+            } else {
+                std::cout << std::left
+                          << std::setw(10) << allocIt->first
+                          << std::setw(10) << allocIt->second.size
+                          << std::setw(15) << "Allocated" << allocIt->second.processName << "\n";
+                ++allocIt;
+            }
+        }
+
+        std::cout << "\nTotal Memory: " << totalMemorySize << " MB\n";
+        std::cout << "Allocated Memory: " << allocatedMemory << " MB\n";
+        std::cout << "Free Memory: " << (totalMemorySize - allocatedMemory) << " MB\n";
+    }
+
+    MemoryStats getStats() const override {
+        MemoryStats stats;
+        stats.totalMemory = totalMemorySize;
+        stats.allocatedMemory = allocatedMemory;
+        stats.requestedMemory = allocatedMemory;
+        stats.allocatedBlocks = static_cast<int>(allocatedBlocks.size());
+        stats.freeBlocks = freeByAddress.size();
+        stats.largestFreeBlock = freeByAddress.largest();
+        return stats;
+    }
+
+private:
+    int findFree(int size) const {
+        switch (strategy) {
+        case FitStrategy::FIRST_FIT:
+            return freeByAddress.firstFit(0, size);
+        case FitStrategy::BEST_FIT: {
+            auto it = freeBySize.lower_bound({size, INT_MIN});
+            return it == freeBySize.end() ? -1 : it->second;
+        }
+        case FitStrategy::WORST_FIT: {
+            // Lowest address among the largest blocks
+            int largest = freeByAddress.largest();
+            return largest < size ? -1 : freeByAddress.firstFit(0, largest);
+        }
+        case FitStrategy::NEXT_FIT: {
+            int start = freeByAddress.firstFit(nextFitCursor, size);
+            return start >= 0 ? start : freeByAddress.firstFit(0, size);
+        }
+        }
+        return -1;
+    }
+
+    // Only best fit searches by size; worst fit is served by the tree's
+    // subtree maxima, so the other strategies skip the size index
+    void indexSize(int size, int start) {
+        if (strategy == FitStrategy::BEST_FIT) {
+            freeBySize.emplace(size, start);
+        }
+    }
+
+    void unindexSize(int size, int start) {
+        if (strategy == FitStrategy::BEST_FIT) {
+            freeBySize.erase({size, start});
+        }
+    }
+
+    void addFree(int start, int size) {
+        freeByAddress.insert(start, size);
+        indexSize(size, start);
+    }
+
+    void removeFree(int start, int size) {
+        freeByAddress.erase(start);
+        unindexSize(size, start);
+    }
+};
+
+#endif
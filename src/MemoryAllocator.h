@@ -0,0 +1,48 @@
+#ifndef MEMORY_ALLOCATOR_H
+#define MEMORY_ALLOCATOR_H
+
+#include <string>
+
+struct MemoryStats {
+    int totalMemory = 0;
+    int allocatedMemory = 0;        // Bytes handed out, including any rounding
+    int requestedMemory = 0;        // Bytes callers asked for
+    int allocatedBlocks = 0;
+    int freeBlocks = 0;
+    int largestFreeBlock = 0;
+
+    int freeMemory() const { return totalMemory - allocatedMemory; }
+
+    // Share of free memory that cannot be used by one request of the
+    // largest size that would otherwise fit: 0 when all free space is one
+    // block, close to 1 when it is scattered in small holes
+    double externalFragmentation() const {
+        int free = freeMemory();
+        return free > 0 ? 1.0 - static_cast<double>(largestFreeBlock) / free : 0.0;
+    }
+
+    // Share of allocated memory lost to rounding up requests
+    double internalFragmentation() const {
+        return allocatedMemory > 0
+            ? static_cast<double>(allocatedMemory - requestedMemory) / allocatedMemory : 0.0;
+    }
+};
+
+// Interface shared by every memory allocation backend
+class MemoryAllocator {
+public:
+    virtual ~MemoryAllocator() = default;
+
+    virtual const char* name() const = 0;
+
+    // Returns the start address, or -1 if the request cannot be satisfied
+    virtual int allocateMemory(int size, const std::string& processName) = 0;
+
+    virtual bool deallocateMemory(int startAddress) = 0;
+
+    virtual void displayMemoryMap() = 0;
+
+    virtual MemoryStats getStats() const = 0;
+};
+
+#endif
@@ -5,8 +5,14 @@
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
-#include <numeric>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "MemoryAllocator.h"
+#include "BlockTable.h"
 
+// One block as a standalone object. MemoryManager itself stores blocks
+// column-wise in a BlockTable.
 class MemoryBlock {
 public:
     int start;
@@ -14,87 +20,197 @@ public:
     bool allocated;
     std::string processName;
 
-    MemoryBlock(int _start, int _size, bool _allocated = false, 
+    MemoryBlock(int _start, int _size, bool _allocated = false,
                 const std::string& _processName = "")
-        : start(_start), size(_size), 
+        : start(_start), size(_size),
           allocated(_allocated), processName(_processName) {}
 };
 
-class MemoryManager {
+// A block moved by compaction. Owners holding oldStart must switch to
+// newStart before their next call.
+struct Relocation {
+    int oldStart;
+    int newStart;
+    int size;
+    std::string processName;
+};
+
+struct CompactionStats {
+    long long steps = 0;
+    long long blocksMoved = 0;
+    long long bytesMoved = 0;
+    long long failuresAvoided = 0;  // Allocations that only fit after compacting
+    long long failures = 0;         // Allocations that failed anyway
+};
+
+// First-fit allocator over an address-ordered block table.
+//
+// With a compaction step size set, allocated blocks are slid toward address
+// 0 a few at a time: one bounded step after each deallocation that leaves a
+// hole, and further steps when a request fails even though enough memory is
+// free in total. Every move is recorded in a relocation map. Memory below
+// packedTo is known to hold no free block, so a step starts there and only
+// touches the blocks it moves and any allocated blocks it skips to reach
+// the first hole.
+class MemoryManager : public MemoryAllocator {
 private:
     int totalMemorySize;
-    std::vector<MemoryBlock> memoryBlocks;
+    BlockTable blocks;
+    std::shared_ptr<OwnerTable> owners;
+    int compactionStep;                         // Bytes moved per step, 0 disables compaction
+    std::vector<Relocation> relocations;        // Pending moves, one per block
+    std::unordered_map<int, std::size_t> pendingAt; // Current start -> entry in relocations
+    int packedTo;                               // No free block starts below this address
+    CompactionStats compactionStats;
 
 public:
-    MemoryManager(int totalSize = 1024) : totalMemorySize(totalSize) {
+    MemoryManager(int totalSize = 1024, int _compactionStep = 0,
+                  std::shared_ptr<OwnerTable> _owners = nullptr)
+        : totalMemorySize(totalSize),
+          owners(_owners ? std::move(_owners) : std::make_shared<OwnerTable>()),
+          compactionStep(std::max(0, _compactionStep)), packedTo(0) {
         // Initialize with one large free block
-        memoryBlocks.emplace_back(0, totalSize, false);
+        blocks.insert(0, 0, totalSize, 0, 0);
+    }
+
+    const char* name() const override {
+        return compactionStep > 0 ? "First Fit (linear, compacting)" : "First Fit (linear)";
     }
 
     // Improved memory allocation with process name
-    int allocateMemory(int size, const std::string& processName) {
-        for (auto& block : memoryBlocks) {
-            if (!block.allocated && block.size >= size) {
-                // If block is larger, split it
-                if (block.size > size) {
-                    MemoryBlock newBlock(
-                        block.start + size, 
-                        block.size - size, 
-                        false
-                    );
-                    block.size = size;
-                    memoryBlocks.push_back(newBlock);
-                }
-
-                // Mark block as allocated
-                block.allocated = true;
-                block.processName = processName;
-                return block.start;
-            }
+    int allocateMemory(int size, const std::string& processName) override {
+        if (size <= 0) {
+            return -1;
+        }
+        uint32_t owner = owners->intern(processName);
+        int start = firstFit(size, owner);
+        if (start >= 0 || compactionStep == 0) {
+            return start;
+        }
+
+        // Enough free memory in total means compaction will make room
+        if (totalMemorySize - calculateAllocatedMemory() < size) {
+            compactionStats.failures++;
+            return -1;
+        }
+        bool complete = false;
+        while (start < 0 && !complete) {
+            complete = compactStep();
+            start = firstFit(size, owner);
         }
-        return -1; // Allocation failed
+        if (start >= 0) {
+            compactionStats.failuresAvoided++;
+        } else {
+            compactionStats.failures++;
+        }
+        return start;
     }
 
     // Improved deallocation
-    bool deallocateMemory(int startAddress) {
-        auto it = std::find_if(memoryBlocks.begin(), memoryBlocks.end(), 
-            [startAddress](const MemoryBlock& block) {
-                return block.start == startAddress && block.allocated;
-            });
-
-        if (it != memoryBlocks.end()) {
-            it->allocated = false;
-            it->processName = "";
-            
-            // Merge with adjacent free blocks
-            mergeAdjacentFreeBlocks();
+    bool deallocateMemory(int startAddress) override {
+        std::size_t i = blocks.find(startAddress);
+        if (i == blocks.size() || !blocks.isAllocated(i)) {
+            return false;
+        }
+        blocks.flags[i] &= ~BlockTable::ALLOCATED;
+        blocks.owners[i] = 0;
+        dropRelocation(startAddress);
+        packedTo = std::min(packedTo, startAddress);
+
+        // Merge with adjacent free blocks
+        if (i + 1 < blocks.size() && !blocks.isAllocated(i + 1)) {
+            blocks.sizes[i] += blocks.sizes[i + 1];
+            blocks.erase(i + 1);
+        }
+        if (i > 0 && !blocks.isAllocated(i - 1)) {
+            blocks.sizes[i - 1] += blocks.sizes[i];
+            blocks.erase(i);
+        }
+        if (compactionStep > 0) {
+            compactStep();
+        }
+        return true;
+    }
+
+    // Slides allocated blocks above the lowest hole down into it, stopping
+    // once compactionStep bytes have moved (at least one block always
+    // moves). Returns true when no allocated block sits above free memory.
+    bool compactStep() {
+        compactionStats.steps++;
+        std::size_t i = blocks.lowerBound(packedTo);
+        while (i < blocks.size() && blocks.isAllocated(i)) {
+            i++;
+        }
+        if (i == blocks.size()) {
+            packedTo = totalMemorySize;
             return true;
         }
-        return false;
+
+        // Free entries are absorbed as the hole sweeps past them, so the
+        // write position never overtakes the read position
+        std::size_t out = i;
+        std::size_t next = i;
+        int hole = blocks.starts[i];
+        int budget = std::max(1, compactionStep);
+        for (; next < blocks.size(); next++) {
+            if (!blocks.isAllocated(next)) {
+                continue;
+            }
+            if (budget <= 0) {
+                break;
+            }
+            recordMove(next, hole);
+            budget -= blocks.sizes[next];
+            blocks.starts[next] = hole;
+            hole += blocks.sizes[next];
+            blocks.move(out++, next);
+        }
+        packedTo = hole;
+
+        // Everything between hole and the first unmoved block is now free
+        int end = next < blocks.size() ? blocks.starts[next] : totalMemorySize;
+        blocks.starts[out] = hole;
+        blocks.sizes[out] = end - hole;
+        blocks.owners[out] = 0;
+        blocks.flags[out] = 0;
+        blocks.erase(out + 1, next);
+        return next == blocks.size();
+    }
+
+    // Moves since the last call, collapsed so each block appears once with
+    // the address its owner last saw and its current address
+    std::vector<Relocation> takeRelocations() {
+        std::vector<Relocation> moves;
+        moves.swap(relocations);
+        pendingAt.clear();
+        return moves;
     }
 
+    const CompactionStats& getCompactionStats() const { return compactionStats; }
+
+    void setCompactionStep(int bytes) { compactionStep = std::max(0, bytes); }
+
+    const OwnerTable& getOwners() const { return *owners; }
+
+    // Heap bytes held by the block table, excluding the shared owner table
+    std::size_t footprintBytes() const { return blocks.footprintBytes(); }
+
     // Display memory map
-    void displayMemoryMap() {
+    void displayMemoryMap() override {
         std::cout << "\n=== Memory Map ===\n";
-        std::cout << std::left 
-                  << std::setw(10) << "Start" 
-                  << std::setw(10) << "Size" 
-                  << std::setw(15) << "Status" 
+        std::cout << std::left
+                  << std::setw(10) << "Start"
+                  << std::setw(10) << "Size"
+                  << std::setw(15) << "Status"
                   << "Process\n";
         std::cout << "---------------------------------------------\n";
 
-        // Sort blocks by start address
-        std::sort(memoryBlocks.begin(), memoryBlocks.end(), 
-            [](const MemoryBlock& a, const MemoryBlock& b) {
-                return a.start < b.start;
-            });
-
-        for (const auto& block : memoryBlocks) {
-            std::cout << std::left 
-                      << std::setw(10) << block.start 
-                      << std::setw(10) << block.size 
-                      << std::setw(15) << (block.allocated ? "Allocated" : "Free")
-                      << (block.allocated ? block.processName : "N/A") << "\n";
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            std::cout << std::left
+                      << std::setw(10) << blocks.starts[i]
+                      << std::setw(10) << blocks.sizes[i]
+                      << std::setw(15) << (blocks.isAllocated(i) ? "Allocated" : "Free")
+                      << (blocks.isAllocated(i) ? owners->nameOf(blocks.owners[i]) : "N/A") << "\n";
         }
 
         // Calculate and display memory usage
@@ -104,38 +220,88 @@ public:
         std::cout << "Free Memory: " << (totalMemorySize - allocatedMemory) << " MB\n";
     }
 
-private:
-    // Merge adjacent free memory blocks
-    void mergeAdjacentFreeBlocks() {
-        std::sort(memoryBlocks.begin(), memoryBlocks.end(), 
-            [](const MemoryBlock& a, const MemoryBlock& b) {
-                return a.start < b.start;
-            });
-
-        for (auto it = memoryBlocks.begin(); it != memoryBlocks.end(); ) {
-            auto next = std::next(it);
-            
-            // If current and next blocks are free and adjacent
-            if (next != memoryBlocks.end() && 
-                !it->allocated && !next->allocated &&
-                it->start + it->size == next->start) {
-                
-                // Merge blocks
-                it->size += next->size;
-                memoryBlocks.erase(next);
-                // Don't increment iterator as vector has changed
+    MemoryStats getStats() const override {
+        MemoryStats stats;
+        stats.totalMemory = totalMemorySize;
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            if (blocks.isAllocated(i)) {
+                stats.allocatedMemory += blocks.sizes[i];
+                stats.allocatedBlocks++;
             } else {
-                ++it;
+                stats.freeBlocks++;
+                stats.largestFreeBlock = std::max(stats.largestFreeBlock, blocks.sizes[i]);
             }
         }
+        stats.requestedMemory = stats.allocatedMemory;
+        return stats;
+    }
+
+private:
+    // Lowest-addressed free block that fits
+    int firstFit(int size, uint32_t owner) {
+        const uint8_t* flags = blocks.flags.data();
+        const int* sizes = blocks.sizes.data();
+        std::size_t count = blocks.size();
+        std::size_t i = 0;
+        // Bitwise | keeps the scan free of data-dependent branches
+        while (i < count && (((flags[i] & BlockTable::ALLOCATED) != 0) | (sizes[i] < size))) {
+            i++;
+        }
+        if (i == count) {
+            return -1; // Allocation failed
+        }
+
+        int start = blocks.starts[i];
+        int remainder = blocks.sizes[i] - size;
+        blocks.sizes[i] = size;
+        blocks.flags[i] |= BlockTable::ALLOCATED;
+        blocks.owners[i] = owner;
+
+        // If block is larger, split it
+        if (remainder > 0) {
+            blocks.insert(i + 1, start + size, remainder, 0, 0);
+        }
+        return start;
+    }
+
+    void recordMove(std::size_t i, int newStart) {
+        int oldStart = blocks.starts[i];
+        auto pending = pendingAt.find(oldStart);
+        if (pending != pendingAt.end()) {
+            std::size_t entry = pending->second;
+            pendingAt.erase(pending);
+            relocations[entry].newStart = newStart;
+            pendingAt[newStart] = entry;
+        } else {
+            pendingAt[newStart] = relocations.size();
+            relocations.push_back({oldStart, newStart, blocks.sizes[i], owners->nameOf(blocks.owners[i])});
+        }
+        compactionStats.blocksMoved++;
+        compactionStats.bytesMoved += blocks.sizes[i];
+    }
+
+    // Forgets the pending move of a block that is being freed
+    void dropRelocation(int start) {
+        auto pending = pendingAt.find(start);
+        if (pending == pendingAt.end()) {
+            return;
+        }
+        std::size_t entry = pending->second;
+        pendingAt.erase(pending);
+        if (entry + 1 != relocations.size()) {
+            relocations[entry] = relocations.back();
+            pendingAt[relocations[entry].newStart] = entry;
+        }
+        relocations.pop_back();
     }
 
     // Calculate total allocated memory
-    int calculateAllocatedMemory() {
-        return std::accumulate(memoryBlocks.begin(), memoryBlocks.end(), 0,
-            [](int total, const MemoryBlock& block) {
-                return total + (block.allocated ? block.size : 0);
-            });
+    int calculateAllocatedMemory() const {
+        int total = 0;
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            total += blocks.isAllocated(i) ? blocks.sizes[i] : 0;
+        }
+        return total;
     }
 };
-#endif
\ No newline at end of file
+#endif
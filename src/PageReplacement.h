@@ -0,0 +1,264 @@
+#ifndef PAGE_REPLACEMENT_H
+#define PAGE_REPLACEMENT_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Packed into one 32-bit word, as a hardware entry would be
+struct PageTableEntry {
+    uint32_t frameNumber : 28;
+    uint32_t valid : 1;
+    uint32_t dirty : 1;
+    uint32_t referenced : 1;
+    uint32_t copyOnWrite : 1;   // Frame is shared read-only; a write copies it
+};
+
+// Chooses which resident page to evict when every frame is in use.
+//
+// A policy sees frames, not pages. PageTable tells it when a frame is loaded
+// and when a resident page is hit. At reset it passes the frame table (the
+// entry held by each frame, or null), which stays valid until the next reset,
+// so policies can read and clear referenced bits. Every operation is O(1)
+// amortized in the number of frames.
+class ReplacementPolicy {
+public:
+    virtual ~ReplacementPolicy() = default;
+
+    virtual const char* name() const = 0;
+
+    // Forgets all frames and starts tracking the given frame table
+    virtual void reset(const std::vector<PageTableEntry*>& frames) = 0;
+
+    // A page was just placed in frame
+    virtual void loaded(int frame) = 0;
+
+    // A resident page in frame was accessed; its referenced bit is already set
+    virtual void touched(int frame) { (void)frame; }
+
+    // Picks an occupied frame to evict and removes it from the policy's
+    // bookkeeping. scanned is increased by the number of frames examined.
+    virtual int victim(long long& scanned) = 0;
+};
+
+// Evicts the page that was loaded first
+class FIFOReplacement : public ReplacementPolicy {
+private:
+    std::vector<int> queue;     // Ring of frames in load order
+    std::size_t head = 0;
+    std::size_t count = 0;
+
+public:
+    const char* name() const override { return "FIFO"; }
+
+    void reset(const std::vector<PageTableEntry*>& frames) override {
+        queue.assign(frames.size(), -1);
+        head = count = 0;
+    }
+
+    void loaded(int frame) override {
+        queue[(head + count++) % queue.size()] = frame;
+    }
+
+    int victim(long long& scanned) override {
+        int frame = queue[head];
+        head = (head + 1) % queue.size();
+        count--;
+        scanned++;
+        return frame;
+    }
+};
+
+// Second chance: the hand skips, and clears, referenced pages
+class ClockReplacement : public ReplacementPolicy {
+private:
+    const std::vector<PageTableEntry*>* frames = nullptr;
+    int frameCount = 0;
+    int hand = 0;
+
+public:
+    const char* name() const override { return "Clock"; }
+
+    void reset(const std::vector<PageTableEntry*>& _frames) override {
+        frames = &_frames;
+        frameCount = static_cast<int>(_frames.size());
+        hand = 0;
+    }
+
+    void loaded(int) override {}
+
+    // Each skip clears a bit that only an access can set again, so the hand
+    // moves at most once per access plus once per eviction
+    int victim(long long& scanned) override {
+        while (true) {
+            PageTableEntry* entry = (*frames)[hand];
+            int frame = hand;
+            hand = hand + 1 == frameCount ? 0 : hand + 1;
+            scanned++;
+            if (entry == nullptr) {
+                continue;
+            }
+            if (!entry->referenced) {
+                return frame;
+            }
+            entry->referenced = false;
+        }
+    }
+};
+
+// Exact LRU: frames on an intrusive doubly linked list, most recent first
+class LRUReplacement : public ReplacementPolicy {
+private:
+    static constexpr int NIL = -1;
+
+    std::vector<int> prev;
+    std::vector<int> next;
+    int mostRecent = NIL;
+    int leastRecent = NIL;
+
+    void unlink(int frame) {
+        if (prev[frame] != NIL) next[prev[frame]] = next[frame]; else mostRecent = next[frame];
+        if (next[frame] != NIL) prev[next[frame]] = prev[frame]; else leastRecent = prev[frame];
+    }
+
+    void pushFront(int frame) {
+        prev[frame] = NIL;
+        next[frame] = mostRecent;
+        if (mostRecent != NIL) prev[mostRecent] = frame; else leastRecent = frame;
+        mostRecent = frame;
+    }
+
+public:
+    const char* name() const override { return "LRU"; }
+
+    void reset(const std::vector<PageTableEntry*>& frames) override {
+        prev.assign(frames.size(), NIL);
+        next.assign(frames.size(), NIL);
+        mostRecent = leastRecent = NIL;
+    }
+
+    void loaded(int frame) override { pushFront(frame); }
+
+    void touched(int frame) override {
+        if (frame != mostRecent) {
+            unlink(frame);
+            pushFront(frame);
+        }
+    }
+
+    int victim(long long& scanned) override {
+        int frame = leastRecent;
+        unlink(frame);
+        scanned++;
+        return frame;
+    }
+};
+
+// Aging (NRU with history): every tick each frame's 8-bit counter is shifted
+// right and the referenced bit enters at the top, then the bit is cleared.
+// The victim has the smallest counter. Frames sit in one bucket per counter
+// value with a bitmap of non-empty buckets, so finding the minimum is a few
+// word scans. A tick touches every frame, and happens once per frameCount
+// references, which keeps the cost O(1) amortized.
+class AgingReplacement : public ReplacementPolicy {
+private:
+    static constexpr int NIL = -1;
+    static constexpr int BUCKETS = 256;
+
+    const std::vector<PageTableEntry*>* frames = nullptr;
+    std::vector<uint8_t> age;
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<bool> resident;
+    int head[BUCKETS];
+    uint64_t nonEmpty[BUCKETS / 64];
+    int tickInterval = 1;
+    int sinceTick = 0;
+
+    void insert(int frame) {
+        int bucket = age[frame];
+        prev[frame] = NIL;
+        next[frame] = head[bucket];
+        if (head[bucket] != NIL) prev[head[bucket]] = frame;
+        head[bucket] = frame;
+        nonEmpty[bucket >> 6] |= uint64_t(1) << (bucket & 63);
+    }
+
+    void remove(int frame) {
+        int bucket = age[frame];
+        if (prev[frame] != NIL) next[prev[frame]] = next[frame]; else head[bucket] = next[frame];
+        if (next[frame] != NIL) prev[next[frame]] = prev[frame];
+        if (head[bucket] == NIL) {
+            nonEmpty[bucket >> 6] &= ~(uint64_t(1) << (bucket & 63));
+        }
+    }
+
+    void countReference() {
+        if (++sinceTick >= tickInterval) {
+            tick();
+        }
+    }
+
+    void clearBuckets() {
+        for (int& h : head) h = NIL;
+        for (uint64_t& word : nonEmpty) word = 0;
+    }
+
+public:
+    const char* name() const override { return "Aging"; }
+
+    void reset(const std::vector<PageTableEntry*>& _frames) override {
+        frames = &_frames;
+        age.assign(_frames.size(), 0);
+        prev.assign(_frames.size(), NIL);
+        next.assign(_frames.size(), NIL);
+        resident.assign(_frames.size(), false);
+        clearBuckets();
+        tickInterval = std::max(1, static_cast<int>(_frames.size()));
+        sinceTick = 0;
+    }
+
+    // A new page counts as just referenced
+    void loaded(int frame) override {
+        age[frame] = 0x80;
+        resident[frame] = true;
+        insert(frame);
+        countReference();
+    }
+
+    void touched(int) override { countReference(); }
+
+    int victim(long long& scanned) override {
+        for (int word = 0; word < BUCKETS / 64; word++) {
+            scanned++;
+            if (nonEmpty[word] != 0) {
+                int bucket = word * 64 + __builtin_ctzll(nonEmpty[word]);
+                int frame = head[bucket];
+                remove(frame);
+                resident[frame] = false;
+                return frame;
+            }
+        }
+        return NIL;
+    }
+
+private:
+    void tick() {
+        sinceTick = 0;
+        clearBuckets();
+        for (int frame = 0; frame < static_cast<int>(age.size()); frame++) {
+            if (!resident[frame]) {
+                continue;
+            }
+            PageTableEntry* entry = (*frames)[frame];
+            bool referenced = entry != nullptr && entry->referenced;
+            age[frame] = static_cast<uint8_t>((age[frame] >> 1) | (referenced ? 0x80 : 0));
+            if (entry != nullptr) {
+                entry->referenced = false;
+            }
+            insert(frame);
+        }
+    }
+};
+
+#endif
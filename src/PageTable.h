@@ -2,57 +2,494 @@
 #define PAGE_TABLE_H
 
 #include <vector>
+#include <memory>
 #include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "PageReplacement.h"
+#include "RadixPageTable.h"
+#include "TLB.h"
+#include "ReferenceTrace.h"
 
-struct PageTableEntry {
-    int frameNumber;
-    bool valid;
-    bool dirty;
-    bool referenced;
+struct PagingStats {
+    long long accesses = 0;
+    long long faults = 0;
+    long long evictions = 0;
+    long long writeBacks = 0;       // Evicted pages that were dirty
+    long long victimScans = 0;      // Frames examined while choosing victims
+    long long tableWalks = 0;       // Accesses that walked the page tables
+    long long forks = 0;
+    long long cowCopies = 0;        // Shared frames copied on a write
+
+    double faultRate() const {
+        return accesses > 0 ? static_cast<double>(faults) / accesses : 0.0;
+    }
+
+    double scansPerEviction() const {
+        return evictions > 0 ? static_cast<double>(victimScans) / evictions : 0.0;
+    }
+};
+
+// Faults and write-backs of one fixed-size window of a trace replay
+struct ReplayWindow {
+    long long references;
+    long long faults;
+    long long writeBacks;
+
+    double faultRate() const {
+        return references > 0 ? static_cast<double>(faults) / references : 0.0;
+    }
 };
 
+struct ReplayReport {
+    long long references = 0;
+    long long rejected = 0;         // Pages outside the address space
+    long long faults = 0;
+    long long writeBacks = 0;
+    double seconds = 0.0;
+    std::vector<ReplayWindow> windows;
+
+    double faultRate() const {
+        long long accepted = references - rejected;
+        return accepted > 0 ? static_cast<double>(faults) / accepted : 0.0;
+    }
+
+    double referencesPerSecond() const {
+        return seconds > 0 ? references / seconds : 0.0;
+    }
+};
+
+// One page table entry mapping a frame, for frames shared after a fork
+struct PageMapping {
+    int pid;
+    int pageNumber;
+    PageTableEntry* entry;
+};
+
+// Demand-paged virtual memory over a shared pool of frames. Each process
+// has its own RadixPageTable, created on first use; accesses go to the
+// current address space, selected with switchAddressSpace. A page is loaded
+// into a free frame on first touch; once every frame is in use the
+// replacement policy picks a victim, and a dirty victim is written back
+// before its frame is reused.
+//
+// fork gives a child the parent's resident frames copy-on-write. A shared
+// frame's primary mapping lives in frameEntries as usual, so replacement
+// policies are unaware of sharing; the other mappings are listed in
+// frameSharers, which holds no entry for unshared frames.
 class PageTable {
 private:
-    std::unordered_map<int, PageTableEntry> pageTable;
+    std::unordered_map<int, std::unique_ptr<RadixPageTable>> addressSpaces;
+    RadixPageTable* current = nullptr;
+    int currentPid = 0;
+    int levels;
+    int pageNumberBits;
     std::vector<int> freeFrames;
+    std::vector<PageTableEntry*> frameEntries;  // [frame] entry of the resident page
+    std::vector<int> framePages;                // [frame] resident page number
+    std::vector<int> frameOwners;               // [frame] pid of the resident page
+    std::vector<int> frameRefs;                 // [frame] entries mapping the frame
+    std::unordered_map<int, std::vector<PageMapping>> frameSharers;
+    long long sharedMappings = 0;               // Mappings beyond the first, over all frames
     int totalFrames;
+    std::unique_ptr<ReplacementPolicy> policy;
+    std::unique_ptr<TLB> tlb;
+    PagingStats stats;
 
 public:
-    PageTable(int numFrames) : totalFrames(numFrames) {
+    PageTable(int numFrames, std::unique_ptr<ReplacementPolicy> _policy = nullptr,
+              int _levels = 2, int _pageNumberBits = 20)
+        : levels(_levels),
+          pageNumberBits(_pageNumberBits),
+          frameEntries(static_cast<std::size_t>(numFrames), nullptr),
+          framePages(static_cast<std::size_t>(numFrames), -1),
+          frameOwners(static_cast<std::size_t>(numFrames), -1),
+          frameRefs(static_cast<std::size_t>(numFrames), 0),
+          totalFrames(numFrames),
+          policy(_policy ? std::move(_policy) : std::unique_ptr<ReplacementPolicy>(new ClockReplacement())) {
         for (int i = 0; i < numFrames; i++) {
             freeFrames.push_back(i);
         }
+        policy->reset(frameEntries);
+        switchAddressSpace(0);
     }
 
-    bool allocatePage(int pageNumber) {
-        if (freeFrames.empty()) {
-            return false;
+    // Makes pid's address space current, creating an empty one if needed
+    void switchAddressSpace(int pid) {
+        std::unique_ptr<RadixPageTable>& space = addressSpaces[pid];
+        if (!space) {
+            space.reset(new RadixPageTable(levels, pageNumberBits));
         }
+        current = space.get();
+        currentPid = pid;
+        if (tlb) {
+            tlb->contextSwitch(pid);
+        }
+    }
 
-        int frame = freeFrames.back();
-        freeFrames.pop_back();
+    // Creates childPid's address space sharing every resident page of
+    // parentPid copy-on-write. Non-resident pages are not inherited. Fails
+    // if the parent does not exist or the child already does.
+    bool fork(int parentPid, int childPid) {
+        auto parent = addressSpaces.find(parentPid);
+        if (parent == addressSpaces.end() || addressSpaces.count(childPid)) {
+            return false;
+        }
+        RadixPageTable* parentSpace = parent->second.get();
+        RadixPageTable* childSpace = new RadixPageTable(levels, pageNumberBits);
+        addressSpaces[childPid].reset(childSpace);
 
-        pageTable[pageNumber] = {
-            frame,      // frameNumber
-            true,       // valid
-            false,      // dirty
-            false       // referenced
-        };
+        parentSpace->forEachValid([&](int pageNumber, PageTableEntry& entry) {
+            int frame = entry.frameNumber;
+            PageTableEntry& copy = childSpace->entryFor(pageNumber);
+            copy.frameNumber = frame;
+            copy.valid = true;
+            copy.dirty = false;         // The primary mapping carries the frame's dirty bit
+            copy.referenced = false;
+            copy.copyOnWrite = true;
+            entry.copyOnWrite = true;
+            frameRefs[frame]++;
+            frameSharers[frame].push_back({childPid, pageNumber, &copy});
+            sharedMappings++;
+        });
+        stats.forks++;
         return true;
     }
 
-    bool accessPage(int pageNumber, bool isWrite = false) {
-        auto it = pageTable.find(pageNumber);
-        if (it == pageTable.end() || !it->second.valid) {
-            return false; // Page fault
+    // Frames that would be in use without sharing, minus those that are
+    long long framesSaved() const { return sharedMappings; }
+
+    // Frees every frame held only by pid and drops its page tables
+    void releaseAddressSpace(int pid) {
+        auto it = addressSpaces.find(pid);
+        if (it == addressSpaces.end()) {
+            return;
+        }
+        it->second->forEachValid([this](int, PageTableEntry& entry) {
+            int frame = entry.frameNumber;
+            if (frameRefs[frame] > 1) {
+                unshare(frame, &entry);
+                return;
+            }
+            frameEntries[frame] = nullptr;
+            framePages[frame] = -1;
+            frameOwners[frame] = -1;
+            frameRefs[frame] = 0;
+            freeFrames.push_back(frame);
+        });
+        addressSpaces.erase(it);
+        if (tlb) {
+            tlb->invalidateAsid(pid);
+        }
+        registerResidentFrames();
+        if (pid == currentPid) {
+            switchAddressSpace(pid);
+        }
+    }
+
+    // Makes the page resident, evicting another page if no frame is free.
+    // Fails when the page is outside the address space or there are no frames.
+    bool allocatePage(int pageNumber) {
+        if (!current->inRange(pageNumber)) {
+            return false;
+        }
+        PageTableEntry* entry = current->find(pageNumber);
+        if (entry != nullptr && entry->valid) {
+            return true;
         }
+        return loadPage(pageNumber) != nullptr;
+    }
 
-        it->second.referenced = true;
+    // Returns false on a page fault. The faulting page is loaded, so the
+    // next access to it hits. Pages outside the address space are rejected.
+    bool accessPage(int pageNumber, bool isWrite = false) {
+        if (!current->inRange(pageNumber)) {
+            return false;
+        }
+        stats.accesses++;
+        PageTableEntry* entry = tlb ? tlb->lookup(currentPid, pageNumber) : nullptr;
+        bool cached = entry != nullptr;
+        if (!cached) {
+            stats.tableWalks++;
+            entry = current->find(pageNumber);
+        }
+        bool hit = entry != nullptr && entry->valid;
+        if (hit) {
+            entry->referenced = true;
+            frameEntries[entry->frameNumber]->referenced = true;    // Policies read the primary entry
+            policy->touched(entry->frameNumber);
+            if (isWrite && entry->copyOnWrite) {
+                entry = copyOnWrite(pageNumber, entry);
+            }
+        } else {
+            stats.faults++;
+            entry = loadPage(pageNumber);
+            if (entry == nullptr) {
+                return false;
+            }
+            entry->referenced = true;
+        }
+        if (tlb && !cached) {
+            tlb->insert(currentPid, pageNumber, entry);
+        }
         if (isWrite) {
-            it->second.dirty = true;
+            entry->dirty = true;
         }
-        return true;
+        return hit;
+    }
+
+    // Replays a reference trace into the current address space, block by
+    // block, and records faults and write-backs per window of references.
+    // Counters continue from the current state; the trace is read to its end.
+    ReplayReport replay(ReferenceTrace& trace, long long window = 100000) {
+        window = std::max(1LL, window);
+        ReplayReport report;
+        PagingStats before = stats;
+        ReplayWindow open = {0, stats.faults, stats.writeBacks};
+        auto begin = std::chrono::steady_clock::now();
+
+        const uint32_t* block;
+        std::size_t count;
+        while ((count = trace.nextBlock(block)) > 0) {
+            report.references += static_cast<long long>(count);
+            std::size_t i = 0;
+            while (i < count) {
+                // Run straight to the end of the block or the window
+                std::size_t stop = std::min(count, i + static_cast<std::size_t>(window - open.references));
+                open.references += static_cast<long long>(stop - i);
+                for (; i < stop; i++) {
+                    accessPage(ReferenceTrace::pageOf(block[i]), ReferenceTrace::isWrite(block[i]));
+                }
+                if (open.references == window) {
+                    closeWindow(report, open);
+                }
+            }
+        }
+        if (open.references > 0) {
+            closeWindow(report, open);
+        }
+
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        report.rejected = report.references - (stats.accesses - before.accesses);
+        report.faults = stats.faults - before.faults;
+        report.writeBacks = stats.writeBacks - before.writeBacks;
+        return report;
+    }
+
+    // Switches policy; resident pages are handed to the new one in frame order
+    void setPolicy(std::unique_ptr<ReplacementPolicy> _policy) {
+        policy = std::move(_policy);
+        registerResidentFrames();
+    }
+
+    // Puts a TLB in front of the page tables, replacing any previous one
+    void enableTLB(const TLBConfig& config) {
+        tlb.reset(new TLB(config));
+        tlb->contextSwitch(currentPid);
+    }
+
+    void disableTLB() { tlb.reset(); }
+
+    // nullptr when no TLB is enabled
+    const TLB* getTLB() const { return tlb.get(); }
+
+    // Average cost of a translated access, ignoring page faults: a TLB probe
+    // (if enabled), one memory reference per level on a walk, and the
+    // access itself
+    double effectiveAccessTime(double tlbNs = 1.0, double memoryNs = 100.0) const {
+        if (stats.accesses == 0) {
+            return 0.0;
+        }
+        double walkRate = static_cast<double>(stats.tableWalks) / stats.accesses;
+        return (tlb ? tlbNs : 0.0) + walkRate * current->getLevels() * memoryNs + memoryNs;
+    }
+
+    const ReplacementPolicy& getPolicy() const { return *policy; }
+    const PagingStats& getStats() const { return stats; }
+    void resetStats() {
+        stats = PagingStats();
+        if (tlb) {
+            tlb->resetStats();
+        }
+    }
+    int getTotalFrames() const { return totalFrames; }
+    int residentPages() const { return totalFrames - static_cast<int>(freeFrames.size()); }
+    int getCurrentPid() const { return currentPid; }
+    int addressSpaceCount() const { return static_cast<int>(addressSpaces.size()); }
+
+    // Bytes held by every process's page tables
+    std::size_t tableFootprintBytes() const {
+        std::size_t bytes = 0;
+        for (const auto& space : addressSpaces) {
+            bytes += space.second->footprintBytes();
+        }
+        return bytes;
+    }
+
+    std::size_t tableCount() const {
+        std::size_t count = 0;
+        for (const auto& space : addressSpaces) {
+            count += space.second->tableCount();
+        }
+        return count;
+    }
+
+    void displayStats() const {
+        std::cout << "\n=== Paging Statistics (" << policy->name() << ") ===\n";
+        std::cout << "Frames:             " << residentPages() << " / " << totalFrames << " in use\n";
+        std::cout << "Address Spaces:     " << addressSpaceCount() << " (current pid " << currentPid << ")\n";
+        std::cout << "Page Tables:        " << tableCount() << " tables, " << tableFootprintBytes()
+                  << " bytes (" << current->getLevels() << " levels)\n";
+        std::cout << "Accesses:           " << stats.accesses << "\n";
+        std::cout << "Page Faults:        " << stats.faults << "\n";
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Fault Rate:         " << stats.faultRate() * 100 << "%\n"
+                  << "Evictions:          " << stats.evictions << "\n"
+                  << "Write-backs:        " << stats.writeBacks << "\n"
+                  << "Scans per Eviction: " << stats.scansPerEviction() << "\n";
+        if (stats.forks > 0) {
+            std::cout << "Copy-on-Write:      " << stats.forks << " forks, " << framesSaved()
+                      << " frames shared, " << stats.cowCopies << " copies\n";
+        }
+        if (tlb) {
+            const TLBConfig& config = tlb->getConfig();
+            const TLBStats& tlbStats = tlb->getStats();
+            std::cout << "TLB:                " << config.entries << " entries, " << config.ways << "-way, "
+                      << (config.replacement == TLBReplacement::LRU ? "LRU" : "random") << ", "
+                      << (config.asidTagging ? "ASID tagged" : "flush on switch") << "\n"
+                      << "TLB Hit Rate:       " << tlbStats.hitRate() * 100 << "% (" << tlbStats.hits << " hits, "
+                      << tlbStats.misses << " misses)\n"
+                      << "TLB Flushes:        " << tlbStats.flushes << " over " << tlbStats.contextSwitches
+                      << " context switches\n";
+        }
+        std::cout << "Effective Access:   " << effectiveAccessTime() << " ns (1 ns TLB, 100 ns memory)\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+private:
+    // Marks one mapping not present; returns whether it was dirty
+    bool unmap(int pid, int pageNumber, PageTableEntry* entry) {
+        bool dirty = entry->dirty;
+        if (tlb) {
+            tlb->invalidate(pid, pageNumber);
+        }
+        entry->valid = false;
+        entry->dirty = false;
+        entry->referenced = false;
+        entry->copyOnWrite = false;
+        return dirty;
+    }
+
+    // open holds counter snapshots until the window is closed
+    void closeWindow(ReplayReport& report, ReplayWindow& open) const {
+        report.windows.push_back({open.references, stats.faults - open.faults, stats.writeBacks - open.writeBacks});
+        open = {0, stats.faults, stats.writeBacks};
+    }
+
+    void registerResidentFrames() {
+        policy->reset(frameEntries);
+        for (int frame = 0; frame < totalFrames; frame++) {
+            if (frameEntries[frame] != nullptr) {
+                policy->loaded(frame);
+            }
+        }
+    }
+
+    // Removes one mapping of a shared frame. If it was the primary, a sharer
+    // takes its place and inherits its referenced and dirty bits. A frame
+    // left with one mapping becomes writable again.
+    void unshare(int frame, PageTableEntry* entry) {
+        auto it = frameSharers.find(frame);
+        std::vector<PageMapping>& sharers = it->second;
+        PageTableEntry* primary = frameEntries[frame];
+        if (primary == entry) {
+            PageMapping heir = sharers.back();
+            sharers.pop_back();
+            heir.entry->referenced = heir.entry->referenced | primary->referenced;
+            heir.entry->dirty = heir.entry->dirty | primary->dirty;
+            frameEntries[frame] = heir.entry;
+            framePages[frame] = heir.pageNumber;
+            frameOwners[frame] = heir.pid;
+        } else {
+            for (std::size_t i = 0; i < sharers.size(); i++) {
+                if (sharers[i].entry == entry) {
+                    sharers[i] = sharers.back();
+                    sharers.pop_back();
+                    break;
+                }
+            }
+        }
+        entry->copyOnWrite = false;
+        frameRefs[frame]--;
+        sharedMappings--;
+        if (sharers.empty()) {
+            frameSharers.erase(it);
+            frameEntries[frame]->copyOnWrite = false;
+        }
+    }
+
+    // First write to a shared page: the writer gets a private frame
+    PageTableEntry* copyOnWrite(int pageNumber, PageTableEntry* entry) {
+        int frame = entry->frameNumber;
+        if (frameRefs[frame] <= 1) {
+            entry->copyOnWrite = false;
+            return entry;
+        }
+        unshare(frame, entry);
+        stats.cowCopies++;
+        PageTableEntry* copy = loadPage(pageNumber);
+        copy->referenced = true;
+        return copy;
+    }
+
+    PageTableEntry* loadPage(int pageNumber) {
+        int frame;
+        if (!freeFrames.empty()) {
+            frame = freeFrames.back();
+            freeFrames.pop_back();
+        } else if (totalFrames > 0) {
+            frame = policy->victim(stats.victimScans);
+            evict(frame);
+        } else {
+            return nullptr;
+        }
+
+        PageTableEntry& entry = current->entryFor(pageNumber);
+        entry.frameNumber = frame;
+        entry.valid = true;
+        entry.dirty = false;
+        entry.referenced = false;
+        entry.copyOnWrite = false;
+        frameEntries[frame] = &entry;
+        frameRefs[frame] = 1;
+        framePages[frame] = pageNumber;
+        frameOwners[frame] = currentPid;
+        policy->loaded(frame);
+        return &entry;
+    }
+
+    // The victim's entries stay in their tables, marked not present. A
+    // shared frame is unmapped from every address space at once.
+    void evict(int frame) {
+        stats.evictions++;
+        bool dirty = unmap(frameOwners[frame], framePages[frame], frameEntries[frame]);
+        auto shared = frameSharers.find(frame);
+        if (shared != frameSharers.end()) {
+            for (const PageMapping& mapping : shared->second) {
+                dirty |= unmap(mapping.pid, mapping.pageNumber, mapping.entry);
+            }
+            sharedMappings -= static_cast<long long>(shared->second.size());
+            frameSharers.erase(shared);
+        }
+        if (dirty) {
+            stats.writeBacks++;
+        }
+        frameRefs[frame] = 0;
+        frameEntries[frame] = nullptr;
+        framePages[frame] = -1;
+        frameOwners[frame] = -1;
     }
 };
 
-#endif
\ No newline at end of file
+#endif
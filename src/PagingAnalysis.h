@@ -0,0 +1,280 @@
+#ifndef PAGING_ANALYSIS_H
+#define PAGING_ANALYSIS_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include "ReferenceTrace.h"
+
+struct OptResult {
+    int frames = 0;
+    long long references = 0;
+    long long faults = 0;
+    long long writeBacks = 0;       // Of the OPT eviction order; not itself minimal
+
+    double faultRate() const {
+        return references > 0 ? static_cast<double>(faults) / references : 0.0;
+    }
+};
+
+struct WorkingSetResult {
+    long long window = 0;           // tau, in references
+    double mean = 0.0;
+    int max = 0;
+    std::vector<double> series;     // Mean working-set size over equal slices of the trace
+};
+
+// LRU miss counts for every frame count at once, from the stack distance
+// histogram: a reference hits in k frames exactly when fewer than k other
+// distinct pages were touched since its previous use. LRU is a stack
+// algorithm, so these match PageTable with LRUReplacement at any size.
+class MissRatioCurve {
+private:
+    long long references = 0;
+    long long coldMisses = 0;
+    std::vector<long long> missesByFrames;  // [k] misses with k frames
+
+public:
+    MissRatioCurve() = default;
+
+    // distanceCounts[d - 1] is the number of re-references at stack distance d
+    MissRatioCurve(long long _references, long long _coldMisses, const std::vector<long long>& distanceCounts)
+        : references(_references), coldMisses(_coldMisses) {
+        missesByFrames.assign(distanceCounts.size() + 1, coldMisses);
+        long long deeper = 0;
+        for (int k = static_cast<int>(distanceCounts.size()); k >= 0; k--) {
+            missesByFrames[k] += deeper;
+            if (k > 0) {
+                deeper += distanceCounts[k - 1];
+            }
+        }
+    }
+
+    long long getReferences() const { return references; }
+    long long getColdMisses() const { return coldMisses; }
+
+    // Frame count beyond which only cold misses remain
+    int maxUsefulFrames() const { return std::max(0, static_cast<int>(missesByFrames.size()) - 1); }
+
+    long long misses(int frames) const {
+        if (frames <= 0) {
+            return references;
+        }
+        return frames < static_cast<int>(missesByFrames.size()) ? missesByFrames[frames] : coldMisses;
+    }
+
+    double missRatio(int frames) const {
+        return references > 0 ? static_cast<double>(misses(frames)) / references : 0.0;
+    }
+
+    // Smallest frame count whose miss ratio is at most target, or -1 when
+    // even cold misses alone exceed it
+    int framesFor(double target) const {
+        int lo = 1, hi = std::max(1, maxUsefulFrames());
+        if (missRatio(hi) > target) {
+            return -1;
+        }
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (missRatio(mid) <= target) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+};
+
+// Offline analysis of a whole reference trace, to judge replacement
+// policies and size PageTable without a simulation per frame count. Page
+// numbers are renumbered densely on load so every pass works on flat arrays.
+class PagingAnalysis {
+private:
+    std::vector<int> pages;         // Dense page id per reference
+    std::vector<uint8_t> writes;
+    int distinctPages = 0;
+
+    void add(int pageNumber, bool isWrite, std::unordered_map<int, int>& ids) {
+        auto inserted = ids.emplace(pageNumber, distinctPages);
+        if (inserted.second) {
+            distinctPages++;
+        }
+        pages.push_back(inserted.first->second);
+        writes.push_back(isWrite ? 1 : 0);
+    }
+
+public:
+    // Reads the trace from its current position to the end
+    explicit PagingAnalysis(ReferenceTrace& trace) {
+        std::unordered_map<int, int> ids;
+        const uint32_t* block;
+        std::size_t count;
+        while ((count = trace.nextBlock(block)) > 0) {
+            for (std::size_t i = 0; i < count; i++) {
+                add(ReferenceTrace::pageOf(block[i]), ReferenceTrace::isWrite(block[i]), ids);
+            }
+        }
+    }
+
+    explicit PagingAnalysis(const std::vector<std::pair<int, bool>>& references) {
+        std::unordered_map<int, int> ids;
+        for (const auto& reference : references) {
+            add(reference.first, reference.second, ids);
+        }
+    }
+
+    long long referenceCount() const { return static_cast<long long>(pages.size()); }
+    int getDistinctPages() const { return distinctPages; }
+
+    // Belady's algorithm: evict the resident page used furthest in the
+    // future. Next uses come from one backward pass; residents sit in a max
+    // heap keyed by next use. Hits push a fresh key and leave the old one to
+    // be skipped, and the heap is rebuilt when stale keys outnumber live
+    // ones, so each reference costs O(log frames) amortized.
+    OptResult optimal(int frames) const {
+        OptResult result;
+        result.frames = frames;
+        int n = static_cast<int>(pages.size());
+        result.references = n;
+        if (frames <= 0) {
+            result.faults = n;
+            return result;
+        }
+
+        std::vector<int> nextUse(n);
+        std::vector<int> upcoming(distinctPages, n);    // n means never again
+        for (int i = n - 1; i >= 0; i--) {
+            nextUse[i] = upcoming[pages[i]];
+            upcoming[pages[i]] = i;
+        }
+
+        std::vector<int> keyOf(distinctPages, -1);      // Live key of a resident page, -1 if absent
+        std::vector<uint8_t> dirty(distinctPages, 0);
+        std::vector<std::pair<int, int>> heap;          // (next use, page)
+        heap.reserve(2 * static_cast<std::size_t>(frames) + 64);
+        int resident = 0;
+
+        for (int i = 0; i < n; i++) {
+            int page = pages[i];
+            if (keyOf[page] < 0) {
+                result.faults++;
+                if (resident == frames) {
+                    while (keyOf[heap.front().second] != heap.front().first) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.pop_back();
+                    }
+                    int victim = heap.front().second;
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.pop_back();
+                    if (dirty[victim]) {
+                        result.writeBacks++;
+                    }
+                    keyOf[victim] = -1;
+                    dirty[victim] = 0;
+                    resident--;
+                }
+                resident++;
+            }
+            keyOf[page] = nextUse[i];
+            dirty[page] |= writes[i];
+            heap.emplace_back(nextUse[i], page);
+            std::push_heap(heap.begin(), heap.end());
+
+            if (heap.size() > 2 * static_cast<std::size_t>(frames) + 64) {
+                heap.erase(std::remove_if(heap.begin(), heap.end(), [&](const std::pair<int, int>& key) {
+                    return keyOf[key.second] != key.first;
+                }), heap.end());
+                std::make_heap(heap.begin(), heap.end());
+            }
+        }
+        return result;
+    }
+
+    // Working-set size W(t, window): distinct pages among the last window
+    // references, kept incrementally with a per-page count in the window
+    WorkingSetResult workingSet(long long window, int points = 100) const {
+        WorkingSetResult result;
+        result.window = std::max(1LL, window);
+        long long n = static_cast<long long>(pages.size());
+        if (n == 0) {
+            return result;
+        }
+        points = static_cast<int>(std::max(1LL, std::min<long long>(points, n)));
+
+        std::vector<int> inWindow(distinctPages, 0);
+        int distinct = 0;
+        double total = 0.0;
+        double sliceTotal = 0.0;
+        long long sliceCount = 0;
+        int slice = 0;
+        for (long long i = 0; i < n; i++) {
+            if (inWindow[pages[i]]++ == 0) {
+                distinct++;
+            }
+            if (i >= result.window && --inWindow[pages[i - result.window]] == 0) {
+                distinct--;
+            }
+            total += distinct;
+            result.max = std::max(result.max, distinct);
+
+            sliceTotal += distinct;
+            sliceCount++;
+            if ((i + 1) * points / n > slice) {
+                result.series.push_back(sliceTotal / sliceCount);
+                sliceTotal = 0.0;
+                sliceCount = 0;
+                slice++;
+            }
+        }
+        result.mean = total / n;
+        return result;
+    }
+
+    // One pass over the trace. A Fenwick tree over reference positions
+    // marks each page's most recent use; the stack distance of a reuse is
+    // the number of marks since the previous use, so the pass is O(n log n).
+    MissRatioCurve missRatioCurve() const {
+        int n = static_cast<int>(pages.size());
+        std::vector<int> tree(static_cast<std::size_t>(n) + 1, 0);
+        std::vector<int> lastUse(distinctPages, 0);     // 1-based position, 0 if not seen
+        std::vector<long long> distanceCounts(distinctPages, 0);
+        long long coldMisses = 0;
+        int marked = 0;
+
+        auto update = [&](int position, int delta) {
+            for (; position <= n; position += position & -position) {
+                tree[position] += delta;
+            }
+        };
+        auto prefix = [&](int position) {
+            int sum = 0;
+            for (; position > 0; position -= position & -position) {
+                sum += tree[position];
+            }
+            return sum;
+        };
+
+        for (int i = 1; i <= n; i++) {
+            int page = pages[i - 1];
+            int previous = lastUse[page];
+            if (previous == 0) {
+                coldMisses++;
+            } else {
+                // Marks after previous: distinct pages touched since
+                int distance = marked - prefix(previous) + 1;
+                distanceCounts[distance - 1]++;
+                update(previous, -1);
+                marked--;
+            }
+            update(i, 1);
+            marked++;
+            lastUse[page] = i;
+        }
+        return MissRatioCurve(n, coldMisses, distanceCounts);
+    }
+};
+
+#endif
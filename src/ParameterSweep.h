@@ -0,0 +1,149 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "Process.h"
+#include "Scheduler.h"
+
+enum class PolicyKind {
+    ROUND_ROBIN,
+    MLFQ,
+    PRIORITY_AGING,
+    SJF,
+    SRTF,
+    FAIR_SHARE
+};
+
+struct SweepPoint {
+    PolicyKind policy;
+    int timeQuantum;
+};
+
+struct SweepResult {
+    SweepPoint point;
+    ScheduleSummary summary;
+};
+
+// Runs one workload under a grid of policies and time quanta, one
+// configuration per thread. Every run reads the same immutable workload and
+// the same arrival order; a run only allocates its own ProcessState array.
+class ParameterSweep {
+private:
+    std::shared_ptr<const std::vector<Process>> workload;
+    std::vector<int> arrivalOrder;
+
+public:
+    ParameterSweep(std::shared_ptr<const std::vector<Process>> _workload)
+        : workload(std::move(_workload)), arrivalOrder(workload->size()) {
+        for (int i = 0; i < static_cast<int>(arrivalOrder.size()); i++) {
+            arrivalOrder[i] = i;
+        }
+        Scheduler::sortByArrival(*workload, arrivalOrder);
+    }
+
+    static std::vector<PolicyKind> allPolicies() {
+        return {PolicyKind::ROUND_ROBIN, PolicyKind::MLFQ, PolicyKind::PRIORITY_AGING,
+                PolicyKind::SJF, PolicyKind::SRTF, PolicyKind::FAIR_SHARE};
+    }
+
+    // Results come back in grid order (policy-major) whatever the thread count
+    std::vector<SweepResult> run(const std::vector<int>& quanta, const std::vector<PolicyKind>& policies,
+                                 int threads = 0) const {
+        std::vector<SweepPoint> grid;
+        for (PolicyKind policy : policies) {
+            for (int quantum : quanta) {
+                grid.push_back({policy, quantum});
+                if (!usesQuantum(policy)) {
+                    break;  // One run is enough
+                }
+            }
+        }
+
+        std::vector<SweepResult> results(grid.size());
+        if (threads <= 0) {
+            threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        threads = std::min(threads, static_cast<int>(grid.size()));
+
+        std::atomic<std::size_t> next(0);
+        auto worker = [&] {
+            for (std::size_t i = next++; i < grid.size(); i = next++) {
+                results[i] = {grid[i], runPoint(grid[i])};
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        return results;
+    }
+
+    static void displayResults(const std::vector<SweepResult>& results) {
+        std::cout << std::left
+                  << std::setw(18) << "Policy"
+                  << std::setw(9) << "Quantum"
+                  << std::setw(12) << "Makespan"
+                  << std::setw(12) << "Switches"
+                  << std::setw(14) << "Turnaround"
+                  << std::setw(12) << "Waiting"
+                  << std::setw(12) << "Response"
+                  << std::setw(16) << "p99 Turnaround"
+                  << "Fairness\n";
+        std::cout << "-------------------------------------------------------------------------------------------------------------\n";
+        std::cout << std::fixed << std::setprecision(2);
+        for (const auto& r : results) {
+            const ScheduleSummary& s = r.summary;
+            std::cout << std::left
+                      << std::setw(18) << s.policy
+                      << std::setw(9) << (usesQuantum(r.point.policy) ? std::to_string(r.point.timeQuantum) : "-")
+                      << std::setw(12) << s.makespan
+                      << std::setw(12) << s.contextSwitches
+                      << std::setw(14) << s.avgTurnaround
+                      << std::setw(12) << s.avgWaiting
+                      << std::setw(12) << s.avgResponse
+                      << std::setw(16) << s.p99Turnaround
+                      << std::setprecision(3) << s.fairness << std::setprecision(2) << "\n";
+        }
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    static bool usesQuantum(PolicyKind policy) {
+        return policy != PolicyKind::SJF && policy != PolicyKind::SRTF;
+    }
+
+private:
+    // The quantum scales every policy that has one: MLFQ levels use q, 2q, 4q
+    // and the fair-share target latency is 10 quanta
+    ScheduleSummary runPoint(const SweepPoint& point) const {
+        int q = std::max(1, point.timeQuantum);
+        switch (point.policy) {
+        case PolicyKind::ROUND_ROBIN:
+            return Scheduler::simulate(*workload, arrivalOrder, RoundRobinPolicy(q));
+        case PolicyKind::MLFQ:
+            return Scheduler::simulate(*workload, arrivalOrder, MLFQPolicy({q, 2 * q, 4 * q}));
+        case PolicyKind::PRIORITY_AGING:
+            return Scheduler::simulate(*workload, arrivalOrder, PriorityAgingPolicy(q));
+        case PolicyKind::SJF:
+            return Scheduler::simulate(*workload, arrivalOrder, SJFPolicy());
+        case PolicyKind::SRTF:
+            return Scheduler::simulate(*workload, arrivalOrder, SRTFPolicy());
+        case PolicyKind::FAIR_SHARE:
+            return Scheduler::simulate(*workload, arrivalOrder, FairSharePolicy(10 * q, q));
+        }
+        return ScheduleSummary{};
+    }
+};
+
+#endif
@@ -10,9 +10,8 @@ public:
     int priority;
     int burstTime;
     int arrivalTime;
-    int remainingTime;
-    bool isCompleted;
-    bool isInQueue;
+    int cpuAffinity;     // Core the process is pinned to, -1 for any
+    int memorySize;      // Pages of virtual memory, 0 for none
 
     Process(int _pid, std::string _name, int _priority, int _burst, int _arrival) {
         pid = _pid;
@@ -20,10 +19,26 @@ public:
         priority = _priority;
         burstTime = _burst;
         arrivalTime = _arrival;
-        remainingTime = _burst;
-        isCompleted = false;
-        isInQueue = false;
+        cpuAffinity = -1;
+        memorySize = 0;
     }
 };
 
-#endif
\ No newline at end of file
+// Scheduling state of one process during one run. It is kept apart from
+// Process so that a read-only workload can be scheduled many times, each run
+// resetting a compact array of these instead of copying every Process.
+struct ProcessState {
+    int remainingTime;
+    int startTime;       // First time on the CPU, -1 until scheduled
+    int completionTime;
+    bool isCompleted;
+    bool isInQueue;
+
+    ProcessState() : remainingTime(0), startTime(-1), completionTime(0),
+                     isCompleted(false), isInQueue(false) {}
+
+    explicit ProcessState(const Process& p) : remainingTime(p.burstTime), startTime(-1),
+                                              completionTime(0), isCompleted(false), isInQueue(false) {}
+};
+
+#endif
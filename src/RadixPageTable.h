@@ -0,0 +1,131 @@
+#ifndef RADIX_PAGE_TABLE_H
+#define RADIX_PAGE_TABLE_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+#include "PageReplacement.h"
+
+// Hierarchical page table for one address space. A page number is split
+// into one index per level, most significant first; the top levels hold
+// pointers to the next level's table and the last level holds the entries.
+// Tables are allocated on first touch, so a sparse address space only pays
+// for the tables that cover its pages. A lookup is one array index per level.
+// Directory slots point at the next level's table, stored as void* because
+// the last directory points at entry tables rather than pointer tables.
+class RadixPageTable {
+public:
+    static constexpr int MIN_LEVELS = 2;
+    static constexpr int MAX_LEVELS = 4;
+
+private:
+    int levels;
+    int pageNumberBits;
+    int shift[MAX_LEVELS];      // Index of level i is (page >> shift[i]) & mask[i]
+    int mask[MAX_LEVELS];
+    std::unique_ptr<void*[]> root;
+    std::vector<std::unique_ptr<void*[]>> directories;         // Non-root pointer tables
+    std::vector<std::unique_ptr<PageTableEntry[]>> leaves;
+    std::size_t directoryBytes = 0;     // Levels may differ in fanout by one bit
+
+    int fanout(int level) const { return mask[level] + 1; }
+
+    void* newTable(int level) {
+        if (level == levels - 1) {
+            leaves.emplace_back(new PageTableEntry[fanout(level)]());
+            return leaves.back().get();
+        }
+        directories.emplace_back(new void*[fanout(level)]());
+        directoryBytes += fanout(level) * sizeof(void*);
+        return directories.back().get();
+    }
+
+public:
+    // Page numbers have pageNumberBits bits, split as evenly as possible
+    // across the levels with the remainder going to the top
+    RadixPageTable(int _levels = 2, int _pageNumberBits = 20) {
+        levels = std::min(MAX_LEVELS, std::max(MIN_LEVELS, _levels));
+        pageNumberBits = std::min(31, std::max(levels, _pageNumberBits));
+        int remaining = pageNumberBits;
+        for (int level = 0; level < levels; level++) {
+            int bits = pageNumberBits / levels + (level < pageNumberBits % levels ? 1 : 0);
+            remaining -= bits;
+            shift[level] = remaining;
+            mask[level] = (1 << bits) - 1;
+        }
+        root.reset(new void*[fanout(0)]());
+    }
+
+    int getLevels() const { return levels; }
+    int getPageNumberBits() const { return pageNumberBits; }
+
+    bool inRange(int pageNumber) const {
+        return pageNumber >= 0 && (pageNumber >> pageNumberBits) == 0;
+    }
+
+    // Entry for the page, or nullptr if no leaf table covers it yet
+    PageTableEntry* find(int pageNumber) const {
+        if (!inRange(pageNumber)) {
+            return nullptr;
+        }
+        void* table = root.get();
+        for (int level = 0; level < levels - 1; level++) {
+            table = static_cast<void**>(table)[(pageNumber >> shift[level]) & mask[level]];
+            if (table == nullptr) {
+                return nullptr;
+            }
+        }
+        return static_cast<PageTableEntry*>(table) + ((pageNumber >> shift[levels - 1]) & mask[levels - 1]);
+    }
+
+    // Entry for the page, allocating the tables on its path. Entries keep
+    // their address for the lifetime of the table. The page must be in range.
+    PageTableEntry& entryFor(int pageNumber) {
+        void* table = root.get();
+        for (int level = 0; level < levels - 1; level++) {
+            void*& slot = static_cast<void**>(table)[(pageNumber >> shift[level]) & mask[level]];
+            if (slot == nullptr) {
+                slot = newTable(level + 1);
+            }
+            table = slot;
+        }
+        return static_cast<PageTableEntry*>(table)[(pageNumber >> shift[levels - 1]) & mask[levels - 1]];
+    }
+
+    // Calls fn(pageNumber, entry) for every valid entry
+    template <typename Fn>
+    void forEachValid(Fn&& fn) {
+        visit(root.get(), 0, 0, fn);
+    }
+
+    std::size_t tableCount() const { return 1 + directories.size() + leaves.size(); }
+
+    // Bytes held by the tables themselves and the vectors that own them
+    std::size_t footprintBytes() const {
+        return sizeof(*this)
+            + fanout(0) * sizeof(void*)
+            + directoryBytes
+            + leaves.size() * fanout(levels - 1) * sizeof(PageTableEntry)
+            + directories.capacity() * sizeof(directories[0])
+            + leaves.capacity() * sizeof(leaves[0]);
+    }
+
+private:
+    template <typename Fn>
+    void visit(void* table, int level, int prefix, Fn& fn) {
+        for (int i = 0; i < fanout(level); i++) {
+            int pageNumber = prefix | (i << shift[level]);
+            if (level == levels - 1) {
+                PageTableEntry& entry = static_cast<PageTableEntry*>(table)[i];
+                if (entry.valid) {
+                    fn(pageNumber, entry);
+                }
+            } else if (static_cast<void**>(table)[i] != nullptr) {
+                visit(static_cast<void**>(table)[i], level + 1, pageNumber, fn);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef REFERENCE_TRACE_H
+#define REFERENCE_TRACE_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Streams memory references (page, read/write) out of a memory-mapped file.
+//
+// Two formats are accepted:
+//   CSV     one "page,op" line per reference, op being R or W; a first line
+//           that does not start with a digit is treated as a header
+//   Binary  the 8-byte magic "OSREFS01", a uint64 reference count, then one
+//           uint32 per reference in host byte order: the page number in the
+//           low 31 bits and the write flag in the top bit
+//
+// References are handed out in blocks. A binary block points straight into
+// the mapping; CSV lines are parsed into a reused block buffer.
+class ReferenceTrace {
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t offset;
+    bool binary;
+    long long malformedLines;
+    std::vector<uint32_t> parsed;   // Current CSV block
+#ifdef _WIN32
+    std::vector<char> buffer;       // No mmap: the file is read into memory instead
+#else
+    int fd;
+#endif
+
+public:
+    static constexpr char MAGIC[8] = {'O', 'S', 'R', 'E', 'F', 'S', '0', '1'};
+    static constexpr std::size_t HEADER_SIZE = 16;
+    static constexpr std::size_t BLOCK_SIZE = 4096;
+    static constexpr uint32_t WRITE_BIT = 0x80000000u;
+
+    static uint32_t encode(int pageNumber, bool isWrite) {
+        return (static_cast<uint32_t>(pageNumber) & ~WRITE_BIT) | (isWrite ? WRITE_BIT : 0);
+    }
+    static int pageOf(uint32_t reference) { return static_cast<int>(reference & ~WRITE_BIT); }
+    static bool isWrite(uint32_t reference) { return (reference & WRITE_BIT) != 0; }
+
+    ReferenceTrace()
+        : data(nullptr), size(0), offset(0), binary(false), malformedLines(0)
+#ifndef _WIN32
+        , fd(-1)
+#endif
+    {}
+
+    ~ReferenceTrace() {
+        close();
+    }
+
+    ReferenceTrace(const ReferenceTrace&) = delete;
+    ReferenceTrace& operator=(const ReferenceTrace&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return false;
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close();
+                return false;
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+#endif
+        binary = size >= HEADER_SIZE && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+        rewind();
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+        data = nullptr;
+        size = offset = 0;
+        malformedLines = 0;
+    }
+
+    // Starts again from the first reference
+    void rewind() {
+        offset = binary ? HEADER_SIZE : 0;
+        malformedLines = 0;
+        if (!binary) {
+            skipCsvHeader();
+        }
+    }
+
+    bool isBinary() const { return binary; }
+    long long getMalformedLines() const { return malformedLines; }
+
+    // Reference count of a binary trace, -1 for CSV
+    long long declaredCount() const {
+        if (!binary) {
+            return -1;
+        }
+        uint64_t count;
+        std::memcpy(&count, data + sizeof(MAGIC), sizeof(count));
+        return static_cast<long long>(count);
+    }
+
+    // Points block at up to maxCount references and returns how many; 0 at
+    // the end of the trace. The block stays valid until the next call.
+    std::size_t nextBlock(const uint32_t*& block, std::size_t maxCount = BLOCK_SIZE) {
+        if (binary) {
+            std::size_t count = std::min(maxCount, (size - offset) / sizeof(uint32_t));
+            // The mapping is page aligned and the header is 16 bytes, so
+            // records are naturally aligned
+            block = reinterpret_cast<const uint32_t*>(data + offset);
+            offset += count * sizeof(uint32_t);
+            return count;
+        }
+
+        parsed.clear();
+        uint32_t reference;
+        while (parsed.size() < maxCount && offset < size) {
+            if (parseCsvLine(reference)) {
+                parsed.push_back(reference);
+            }
+        }
+        block = parsed.data();
+        return parsed.size();
+    }
+
+    // Streams a CSV trace into the binary format. Returns references
+    // written, or -1 if either file could not be opened.
+    static long long convertCsvToBinary(const std::string& csvPath, const std::string& binaryPath) {
+        ReferenceTrace reader;
+        if (!reader.open(csvPath)) {
+            return -1;
+        }
+        std::FILE* out = std::fopen(binaryPath.c_str(), "wb");
+        if (out == nullptr) {
+            return -1;
+        }
+
+        uint64_t count = 0;
+        std::fwrite(MAGIC, 1, sizeof(MAGIC), out);
+        std::fwrite(&count, sizeof(count), 1, out);
+
+        const uint32_t* block;
+        std::size_t blockCount;
+        while ((blockCount = reader.nextBlock(block)) > 0) {
+            std::fwrite(block, sizeof(uint32_t), blockCount, out);
+            count += blockCount;
+        }
+
+        // Patch the reference count into the header
+        std::fseek(out, sizeof(MAGIC), SEEK_SET);
+        std::fwrite(&count, sizeof(count), 1, out);
+        std::fclose(out);
+        return static_cast<long long>(count);
+    }
+
+private:
+    void skipCsvHeader() {
+        std::size_t i = offset;
+        while (i < size && (data[i] == ' ' || data[i] == '\t')) {
+            i++;
+        }
+        if (i < size && (data[i] < '0' || data[i] > '9')) {
+            const void* newline = std::memchr(data + offset, '\n', size - offset);
+            offset = newline ? static_cast<const char*>(newline) - data + 1 : size;
+        }
+    }
+
+    // Parses one line in place; blank and malformed lines are skipped
+    bool parseCsvLine(uint32_t& reference) {
+        std::size_t lineStart = offset;
+        const void* newline = std::memchr(data + offset, '\n', size - offset);
+        std::size_t lineEnd = newline ? static_cast<const char*>(newline) - data : size;
+        offset = newline ? lineEnd + 1 : size;
+
+        const char* p = data + lineStart;
+        const char* end = data + lineEnd;
+        while (end > p && (end[-1] == '\r' || end[-1] == ' ')) {
+            end--;
+        }
+        while (p < end && *p == ' ') {
+            p++;
+        }
+        if (p == end) {
+            return false;
+        }
+
+        long long page = 0;
+        const char* digits = p;
+        while (p < end && *p >= '0' && *p <= '9' && page <= 0x7fffffff) {
+            page = page * 10 + (*p - '0');
+            p++;
+        }
+        while (p < end && *p == ' ') {
+            p++;
+        }
+        if (p == digits || page > 0x7fffffff || p == end || *p != ',') {
+            malformedLines++;
+            return false;
+        }
+        p++;
+        while (p < end && *p == ' ') {
+            p++;
+        }
+        if (end - p != 1 || (*p != 'R' && *p != 'r' && *p != 'W' && *p != 'w')) {
+            malformedLines++;
+            return false;
+        }
+        reference = encode(static_cast<int>(page), *p == 'W' || *p == 'w');
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,379 @@
+#ifndef SMP_SCHEDULER_H
+#define SMP_SCHEDULER_H
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "Process.h"
+#include "SchedulingMetrics.h"
+
+struct SMPConfig {
+    int cores = 4;
+    int timeQuantum = 2;
+    int epochQuanta = 16;       // Quanta each core runs between balancing points
+    bool workStealing = true;
+    bool useAffinity = true;    // Honour Process::cpuAffinity
+    bool threaded = true;       // One host thread per simulated core
+    unsigned seed = 1;
+};
+
+struct SMPCoreStats {
+    long long busyTime = 0;
+    long long completed = 0;
+    long long contextSwitches = 0;
+    long long migrations = 0;   // Slices run here after last running elsewhere
+    long long steals = 0;       // Processes this core stole from others
+};
+
+struct SMPReport {
+    int cores = 0;
+    long long completed = 0;
+    long long makespan = 0;
+    long long migrations = 0;
+    long long stealOperations = 0;
+    double loadImbalance = 0.0; // Busiest core's busy time over the mean, 1.0 is perfect
+    std::vector<SMPCoreStats> perCore;
+    SchedulingMetrics metrics;  // Merged from every core
+};
+
+// Reusable barrier for the worker threads (std::barrier needs C++20)
+class EpochBarrier {
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    int parties;
+    int waiting;
+    long long generation;
+
+public:
+    EpochBarrier(int _parties) : parties(_parties), waiting(0), generation(0) {}
+
+    void arriveAndWait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        long long gen = generation;
+        if (++waiting == parties) {
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return gen != generation; });
+        }
+    }
+};
+
+// N-core Round Robin with one run queue per core.
+//
+// Time advances in epochs of epochQuanta * timeQuantum. At each epoch
+// boundary a single thread places new arrivals (pinned ones on their core,
+// the rest on the shortest queue) and balances the queues. Every core whose
+// remaining work would not fill the coming epoch, so that it would go idle
+// part way through, steals unpinned processes from a core holding more
+// than an epoch of work. Thieves go in core-id order and each picks its
+// victim with a seeded RNG. Between boundaries every core runs its own
+// queue on its own host thread and only touches processes in that queue,
+// so the result depends on the seed alone, never on thread timing.
+class SMPScheduler {
+private:
+    struct Core {
+        std::deque<int> queue;      // Ready processes (indices)
+        std::deque<int> incoming;   // Placed here, arriving later this epoch
+        long long work = 0;         // Remaining time of everything in queue and incoming
+        long long clock = 0;
+        int lastIndex = -1;
+        SchedulingMetrics metrics;
+        SMPCoreStats stats;
+    };
+
+    const std::vector<Process>& processes;
+    std::vector<ProcessState>& states;
+    const std::vector<int>& arrivalOrder;
+    std::size_t nextArrival;
+    SMPConfig config;
+    std::vector<Core> cores;
+    std::vector<int> lastCore;      // Core each process last ran on
+    std::mt19937 rng;
+    long long stealOperations;
+
+public:
+    SMPScheduler(const std::vector<Process>& _processes, std::vector<ProcessState>& _states,
+                 const std::vector<int>& _arrivalOrder, std::size_t firstArrival, const SMPConfig& _config)
+        : processes(_processes), states(_states), arrivalOrder(_arrivalOrder), nextArrival(firstArrival),
+          config(_config), cores(std::max(1, _config.cores)),
+          lastCore(_processes.size(), -1), rng(_config.seed),
+          stealOperations(0) {
+        config.cores = static_cast<int>(cores.size());
+        config.timeQuantum = std::max(1, config.timeQuantum);
+        config.epochQuanta = std::max(1, config.epochQuanta);
+    }
+
+    SMPReport run(long long startTime) {
+        long long epochLength = static_cast<long long>(config.epochQuanta) * config.timeQuantum;
+        long long epochStart = startTime;
+        long long epochEnd = epochStart + epochLength;
+        for (auto& core : cores) {
+            core.clock = startTime;
+        }
+
+        std::vector<std::thread> workers;
+        EpochBarrier barrier(config.cores);
+        bool finished = false;
+
+        // Core 0 runs on the calling thread; the others wait at the barrier
+        // for each epoch, run it, and report back at the barrier.
+        if (config.threaded) {
+            for (int c = 1; c < config.cores; c++) {
+                workers.emplace_back([&, c] {
+                    while (true) {
+                        barrier.arriveAndWait();
+                        if (finished) {
+                            return;
+                        }
+                        runEpoch(cores[c], c, epochStart, epochEnd);
+                        barrier.arriveAndWait();
+                    }
+                });
+            }
+        }
+
+        while (true) {
+            epochEnd = epochStart + epochLength;
+            placeArrivals(epochEnd);
+            if (config.workStealing) {
+                balance(epochLength);
+            }
+
+            if (allIdle()) {
+                if (nextArrival == arrivalOrder.size()) {
+                    break;
+                }
+                // Whole machine is idle: skip to the next arrival
+                epochStart = std::max(epochStart, static_cast<long long>(processes[arrivalOrder[nextArrival]].arrivalTime));
+                continue;
+            }
+
+            if (config.threaded) {
+                barrier.arriveAndWait();
+                runEpoch(cores[0], 0, epochStart, epochEnd);
+                barrier.arriveAndWait();
+            } else {
+                for (int c = 0; c < config.cores; c++) {
+                    runEpoch(cores[c], c, epochStart, epochEnd);
+                }
+            }
+            epochStart = epochEnd;
+        }
+
+        if (config.threaded) {
+            finished = true;
+            barrier.arriveAndWait();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+        return buildReport();
+    }
+
+private:
+    bool allIdle() const {
+        for (const auto& core : cores) {
+            if (!core.queue.empty() || !core.incoming.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int pinnedCore(const Process& p) const {
+        if (!config.useAffinity || p.cpuAffinity < 0) {
+            return -1;
+        }
+        return p.cpuAffinity % config.cores;
+    }
+
+    // Place every process arriving before epochEnd on a core
+    void placeArrivals(long long epochEnd) {
+        while (nextArrival < arrivalOrder.size() &&
+               processes[arrivalOrder[nextArrival]].arrivalTime < epochEnd) {
+            int index = arrivalOrder[nextArrival++];
+            int target = pinnedCore(processes[index]);
+            if (target < 0) {
+                target = 0;
+                for (int c = 1; c < config.cores; c++) {
+                    if (load(cores[c]) < load(cores[target])) {
+                        target = c;
+                    }
+                }
+            }
+            states[index].isInQueue = true;
+            cores[target].incoming.push_back(index);
+            cores[target].work += states[index].remainingTime;
+        }
+    }
+
+    static std::size_t load(const Core& core) {
+        return core.queue.size() + core.incoming.size();
+    }
+
+    // Cores that would run dry within the next epoch steal from the back of
+    // a randomly chosen core with more than an epoch of work, taking at
+    // most half its queue, until they have an epoch's worth. A process only
+    // moves if the victim keeps at least as much work as the thief ends
+    // up with, so one long job is never passed back and forth.
+    void balance(long long epochLength) {
+        std::vector<int> victims;
+        for (int thief = 0; thief < config.cores; thief++) {
+            Core& to = cores[thief];
+            if (to.work >= epochLength) {
+                continue;
+            }
+
+            victims.clear();
+            for (int c = 0; c < config.cores; c++) {
+                if (c != thief && cores[c].queue.size() > 1 && cores[c].work > epochLength) {
+                    victims.push_back(c);
+                }
+            }
+            if (victims.empty()) {
+                return;
+            }
+
+            Core& victim = cores[victims[rng() % victims.size()]];
+            std::size_t toSteal = victim.queue.size() / 2;
+            std::deque<int> kept;
+            bool stole = false;
+            // Take from the back: those processes would wait longest anyway
+            while (!victim.queue.empty() && toSteal > 0 && to.work < epochLength) {
+                int index = victim.queue.back();
+                victim.queue.pop_back();
+                int remaining = states[index].remainingTime;
+                if (pinnedCore(processes[index]) >= 0 || victim.work - remaining < to.work + remaining) {
+                    kept.push_front(index);
+                    continue;
+                }
+                to.queue.push_front(index);
+                to.work += remaining;
+                victim.work -= remaining;
+                to.stats.steals++;
+                toSteal--;
+                stole = true;
+            }
+            victim.queue.insert(victim.queue.end(), kept.begin(), kept.end());
+            if (stole) {
+                stealOperations++;
+            }
+        }
+    }
+
+    // Runs on the core's own thread; touches only this core and its processes
+    void runEpoch(Core& core, int coreId, long long epochStart, long long epochEnd) {
+        core.clock = std::max(core.clock, epochStart);
+        while (true) {
+            while (!core.incoming.empty() &&
+                   processes[core.incoming.front()].arrivalTime <= core.clock) {
+                core.queue.push_back(core.incoming.front());
+                core.incoming.pop_front();
+            }
+
+            if (core.queue.empty()) {
+                if (core.incoming.empty()) {
+                    break;
+                }
+                core.clock = std::max(core.clock, static_cast<long long>(processes[core.incoming.front()].arrivalTime));
+                continue;
+            }
+            if (core.clock >= epochEnd) {
+                break;
+            }
+
+            int index = core.queue.front();
+            core.queue.pop_front();
+            ProcessState& current = states[index];
+            core.metrics.recordDispatch(index, core.lastIndex != index && core.lastIndex != -1);
+            core.lastIndex = index;
+            if (current.startTime < 0) {
+                current.startTime = static_cast<int>(core.clock);
+            }
+            if (lastCore[index] != coreId && lastCore[index] != -1) {
+                core.stats.migrations++;
+            }
+            lastCore[index] = coreId;
+
+            int executeTime = std::min(config.timeQuantum, current.remainingTime);
+            current.remainingTime -= executeTime;
+            core.work -= executeTime;
+            core.clock += executeTime;
+            core.stats.busyTime += executeTime;
+
+            if (current.remainingTime > 0) {
+                core.queue.push_back(index);
+            } else {
+                current.isInQueue = false;
+                current.isCompleted = true;
+                current.completionTime = static_cast<int>(core.clock);
+                core.stats.completed++;
+                core.metrics.recordCompletion(index, processes[index], current, current.completionTime);
+            }
+        }
+        // An idle core still owns the whole epoch
+        core.clock = std::max(core.clock, epochEnd);
+    }
+
+    SMPReport buildReport() {
+        SMPReport report;
+        report.cores = config.cores;
+        report.stealOperations = stealOperations;
+
+        long long maxBusy = 0, totalBusy = 0;
+        for (auto& core : cores) {
+            core.stats.contextSwitches = core.metrics.getContextSwitches();
+            report.perCore.push_back(core.stats);
+            report.metrics.merge(core.metrics);
+            report.completed += core.stats.completed;
+            report.migrations += core.stats.migrations;
+            totalBusy += core.stats.busyTime;
+            maxBusy = std::max(maxBusy, core.stats.busyTime);
+        }
+
+        report.makespan = report.metrics.getMakespan();
+        if (totalBusy > 0) {
+            report.loadImbalance = static_cast<double>(maxBusy) * config.cores / totalBusy;
+        }
+        return report;
+    }
+
+public:
+    static void displayReport(const SMPReport& report) {
+        report.metrics.writeReport(std::cout);
+        std::cout << "\nCores: " << report.cores
+                  << std::fixed << std::setprecision(2)
+                  << "  Load imbalance: " << report.loadImbalance;
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << "  Migrations: " << report.migrations
+                  << "  Steal operations: " << report.stealOperations << "\n\n";
+
+        std::cout << std::left
+                  << std::setw(8) << "Core"
+                  << std::setw(12) << "Busy"
+                  << std::setw(12) << "Completed"
+                  << std::setw(12) << "Switches"
+                  << "Stolen\n";
+        std::cout << "--------------------------------------------------\n";
+        for (std::size_t c = 0; c < report.perCore.size(); c++) {
+            const auto& s = report.perCore[c];
+            std::cout << std::left
+                      << std::setw(8) << c
+                      << std::setw(12) << s.busyTime
+                      << std::setw(12) << s.completed
+                      << std::setw(12) << s.contextSwitches
+                      << s.steals << "\n";
+        }
+    }
+};
+
+#endif
@@ -1,62 +1,387 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
+#include <deque>
 #include <queue>
 #include <vector>
+#include <functional>
 #include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
 #include "Process.h"
+#include "SchedulingPolicies.h"
+#include "SchedulingMetrics.h"
+#include "SMPScheduler.h"
+#include "TraceReader.h"
+
+struct ScheduleSummary {
+    const char* policy;
+    long long completed;
+    long long makespan;
+    long long contextSwitches;
+    double avgTurnaround;
+    double avgWaiting;
+    double avgResponse;
+    long long p99Turnaround;
+    double fairness;
+};
 
 class Scheduler {
 private:
     std::vector<Process> processes;
-    std::queue<Process> readyQueue;
+    std::vector<ProcessState> states;   // Parallel to processes
+    std::vector<int> arrivalOrder;   // Indices into processes, sorted by arrival time
+    std::size_t nextArrival;         // Cursor into arrivalOrder
     int timeQuantum;
     int currentTime;
+    SchedulingMetrics metrics;
 
 public:
-    Scheduler(int quantum = 2) : timeQuantum(quantum), currentTime(0) {}
-    
+    Scheduler(int quantum = 2) : nextArrival(0), timeQuantum(quantum), currentTime(0) {}
+
     void addProcess(Process p) {
-        processes.push_back(p);
+        states.emplace_back(p);
+        processes.push_back(std::move(p));
+    }
+
+    void reserve(std::size_t count) {
+        processes.reserve(count);
+        states.reserve(count);
+    }
+
+    const std::vector<Process>& getProcesses() const {
+        return processes;
+    }
+
+    int getCurrentTime() const {
+        return currentTime;
+    }
+
+    long long getContextSwitches() const {
+        return metrics.getContextSwitches();
     }
-    
+
+    // Metrics of the most recent run
+    const SchedulingMetrics& getMetrics() const {
+        return metrics;
+    }
+
     void executeRoundRobin() {
-        // Initialize ready queue
-        for (auto& p : processes) {
-            if (p.arrivalTime <= currentTime && !p.isCompleted && !p.isInQueue) {
-                readyQueue.push(p);
-                p.isInQueue = true; // Mark the process as added to the queue
+        metrics.setKeepPerProcess(true);
+        runRoundRobin([](const Process&, int) {});
+        metrics.writeReport(std::cout);
+    }
+
+    template <typename OnComplete>
+    void runRoundRobin(OnComplete onComplete) {
+        RoundRobinPolicy policy(timeQuantum);
+        run(policy, onComplete);
+    }
+
+    // Event-driven scheduling loop shared by every policy. Arrivals are
+    // consumed through a sorted cursor and policies only ever see indices, so
+    // the per-slice cost is whatever the policy's queue operations cost.
+    // The policy type is a template parameter: no virtual calls per slice.
+    template <typename Policy, typename OnComplete>
+    void run(Policy& policy, OnComplete onComplete) {
+        run(policy, onComplete, [](const Process&, int) {});
+    }
+
+    // As above, also calling onDispatch(process, executeTime) each time a
+    // process is given the CPU, before its slice runs. Consecutive slices of
+    // the same process are separate dispatches. If onDispatch returns a
+    // positive number, the process blocks for that long once its slice ends
+    // (waiting for page-ins, say) and the CPU goes to another process.
+    template <typename Policy, typename OnComplete, typename OnDispatch>
+    void run(Policy& policy, OnComplete onComplete, OnDispatch onDispatch) {
+        prepareArrivals();
+        CursorArrivals arrivals{processes, arrivalOrder, nextArrival};
+        runLoop(processes, states, arrivals, policy, metrics, currentTime, onComplete, onDispatch);
+    }
+
+    // Replays a workload trace. Records are pulled from the reader only as
+    // they arrive and each one occupies a slot in processes until it
+    // completes, after which the slot is reused, so memory follows the number
+    // of live processes rather than the trace length. Use a scheduler that
+    // is dedicated to the trace.
+    template <typename Policy, typename OnComplete>
+    void replay(TraceReader& trace, Policy& policy, OnComplete onComplete) {
+        TraceArrivals arrivals{processes, states, trace, {}, {}};
+        runLoop(processes, states, arrivals, policy, metrics, currentTime, onComplete,
+                [](const Process&, int) {});
+    }
+
+    // Multi-core Round Robin with per-core run queues and work stealing
+    SMPReport runSMP(SMPConfig config) {
+        prepareArrivals();
+        config.timeQuantum = timeQuantum;
+        SMPScheduler smp(processes, states, arrivalOrder, nextArrival, config);
+        SMPReport report = smp.run(currentTime);
+        nextArrival = arrivalOrder.size();
+        currentTime = std::max(currentTime, static_cast<int>(report.makespan));
+        return report;
+    }
+
+    // Run a policy over every process added so far, leaving this
+    // scheduler's own state untouched
+    template <typename Policy>
+    ScheduleSummary simulate(Policy policy) const {
+        std::vector<int> order(processes.size());
+        for (int i = 0; i < static_cast<int>(order.size()); i++) {
+            order[i] = i;
+        }
+        sortByArrival(processes, order);
+        return simulate(processes, order, policy);
+    }
+
+    // Run a policy over a read-only workload. Only a ProcessState per process
+    // is allocated, so many runs can share one workload, even concurrently.
+    template <typename Policy>
+    static ScheduleSummary simulate(const std::vector<Process>& workload,
+                                    const std::vector<int>& arrivalOrder, Policy policy) {
+        std::vector<ProcessState> runStates;
+        runStates.reserve(workload.size());
+        for (const auto& p : workload) {
+            runStates.emplace_back(p);
+        }
+
+        SchedulingMetrics runMetrics;
+        std::size_t cursor = 0;
+        int time = 0;
+        CursorArrivals arrivals{workload, arrivalOrder, cursor};
+        runLoop(workload, runStates, arrivals, policy, runMetrics, time,
+                [](const Process&, int) {}, [](const Process&, int) {});
+
+        return {policy.name(), runMetrics.completed(), time, runMetrics.getContextSwitches(),
+                runMetrics.turnaround().mean(), runMetrics.waiting().mean(), runMetrics.response().mean(),
+                runMetrics.turnaround().percentile(0.99), runMetrics.fairnessIndex()};
+    }
+
+    // Stable, so processes arriving together keep their submission order
+    static void sortByArrival(const std::vector<Process>& workload, std::vector<int>& order) {
+        auto byArrival = [&workload](int a, int b) {
+            return workload[a].arrivalTime < workload[b].arrivalTime;
+        };
+        if (!std::is_sorted(order.begin(), order.end(), byArrival)) {
+            std::stable_sort(order.begin(), order.end(), byArrival);
+        }
+    }
+
+    std::vector<ScheduleSummary> comparePolicies() const {
+        return {
+            simulate(RoundRobinPolicy(timeQuantum)),
+            simulate(MLFQPolicy()),
+            simulate(PriorityAgingPolicy(timeQuantum)),
+            simulate(SJFPolicy()),
+            simulate(SRTFPolicy()),
+            simulate(FairSharePolicy()),
+        };
+    }
+
+    static void displaySummaries(const std::vector<ScheduleSummary>& summaries) {
+        std::cout << std::left
+                  << std::setw(18) << "Policy"
+                  << std::setw(10) << "Done"
+                  << std::setw(12) << "Makespan"
+                  << std::setw(12) << "Switches"
+                  << std::setw(14) << "Turnaround"
+                  << std::setw(12) << "Waiting"
+                  << std::setw(12) << "Response"
+                  << std::setw(16) << "p99 Turnaround"
+                  << "Fairness\n";
+        std::cout << "----------------------------------------------------------------------------------------------------\n";
+        std::cout << std::fixed << std::setprecision(2);
+        for (const auto& s : summaries) {
+            std::cout << std::left
+                      << std::setw(18) << s.policy
+                      << std::setw(10) << s.completed
+                      << std::setw(12) << s.makespan
+                      << std::setw(12) << s.contextSwitches
+                      << std::setw(14) << s.avgTurnaround
+                      << std::setw(12) << s.avgWaiting
+                      << std::setw(12) << s.avgResponse
+                      << std::setw(16) << s.p99Turnaround
+                      << std::setprecision(3) << s.fairness << std::setprecision(2) << "\n";
+        }
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+private:
+    // Collect every process not yet scheduled and order it by arrival time.
+    // Runs once per call, not once per time slice.
+    void prepareArrivals() {
+        arrivalOrder.clear();
+        nextArrival = 0;
+        for (int i = 0; i < static_cast<int>(processes.size()); i++) {
+            if (!states[i].isCompleted && !states[i].isInQueue) {
+                arrivalOrder.push_back(i);
             }
         }
+        sortByArrival(processes, arrivalOrder);
+    }
 
-        while (!readyQueue.empty()) {
-            Process current = readyQueue.front();
-            readyQueue.pop();
-            current.isInQueue = false; // Mark the process as removed from the queue
+    // Arrival source over processes already held in memory
+    struct CursorArrivals {
+        const std::vector<Process>& processes;
+        const std::vector<int>& order;
+        std::size_t& cursor;
 
-            // Execute for time quantum or remaining time
-            int executeTime = std::min(timeQuantum, current.remainingTime);
-            current.remainingTime -= executeTime;
-            currentTime += executeTime;
+        bool pending() {
+            return cursor < order.size();
+        }
 
-            // Check if process is completed
-            if (current.remainingTime > 0) {
-                readyQueue.push(current);
-                current.isInQueue = true; // Mark the process as added to the queue again
-            } else {
-                current.isCompleted = true;
-                std::cout << "Process " << current.pid << " completed at time " << currentTime << std::endl;
+        int nextTime() {
+            return processes[order[cursor]].arrivalTime;
+        }
+
+        int admit() {
+            return order[cursor++];
+        }
+
+        void release(int) {}
+    };
+
+    // Arrival source that materializes trace records into reusable slots
+    struct TraceArrivals {
+        std::vector<Process>& processes;
+        std::vector<ProcessState>& states;
+        TraceReader& trace;
+        TraceRecord record;
+        std::vector<int> freeSlots;
+
+        bool pending() {
+            return trace.peek(record);
+        }
+
+        int nextTime() {
+            return record.arrivalTime;
+        }
+
+        int admit() {
+            trace.next(record);
+            if (freeSlots.empty()) {
+                processes.push_back(record.toProcess());
+                states.emplace_back(processes.back());
+                return static_cast<int>(processes.size()) - 1;
+            }
+            int slot = freeSlots.back();
+            freeSlots.pop_back();
+            processes[slot] = record.toProcess();
+            states[slot] = ProcessState(processes[slot]);
+            return slot;
+        }
+
+        void release(int index) {
+            freeSlots.push_back(index);
+        }
+    };
+
+    // A process waiting out a dispatch stall
+    struct Blocked {
+        int wakeTime;
+        int index;
+        int ran;                    // Length of the slice that blocked
+        bool operator>(const Blocked& other) const {
+            return wakeTime != other.wakeTime ? wakeTime > other.wakeTime : index > other.index;
+        }
+    };
+
+    template <typename OnDispatch>
+    static int dispatchStall(OnDispatch& onDispatch, const Process& p, int executeTime) {
+        if constexpr (std::is_void<decltype(onDispatch(p, executeTime))>::value) {
+            onDispatch(p, executeTime);
+            return 0;
+        } else {
+            return static_cast<int>(onDispatch(p, executeTime));
+        }
+    }
+
+    template <typename Arrivals, typename Policy, typename OnComplete, typename OnDispatch>
+    static void runLoop(const std::vector<Process>& processes, std::vector<ProcessState>& states,
+                        Arrivals& arrivals, Policy& policy, SchedulingMetrics& metrics,
+                        int& currentTime, OnComplete onComplete, OnDispatch onDispatch) {
+        policy.reset(processes.size());
+        metrics.reset(processes.size());
+        std::priority_queue<Blocked, std::vector<Blocked>, std::greater<Blocked>> blocked;
+        int lastIndex = -1;
+
+        auto complete = [&](int index, int time) {
+            ProcessState& state = states[index];
+            state.isInQueue = false;
+            state.isCompleted = true;
+            state.completionTime = time;
+            metrics.recordCompletion(index, processes[index], state, time);
+            onComplete(processes[index], time);
+            arrivals.release(index);
+        };
+
+        while (true) {
+            while (arrivals.pending() && arrivals.nextTime() <= currentTime) {
+                int index = arrivals.admit();
+                states[index].isInQueue = true; // Mark the process as added to the queue
+                policy.admit(index, processes[index], states[index], currentTime);
+            }
+            while (!blocked.empty() && blocked.top().wakeTime <= currentTime) {
+                Blocked woken = blocked.top();
+                blocked.pop();
+                if (states[woken.index].remainingTime > 0) {
+                    policy.requeue(woken.index, processes[woken.index], states[woken.index], woken.ran, currentTime);
+                } else {
+                    complete(woken.index, woken.wakeTime);
+                }
             }
 
-            // Add newly arrived processes
-            for (auto& p : processes) {
-                if (!p.isCompleted && p.arrivalTime <= currentTime && !p.isInQueue) {
-                    readyQueue.push(p);
-                    p.isInQueue = true; // Mark the process as added to the queue
+            if (policy.empty()) {
+                if (!arrivals.pending() && blocked.empty()) {
+                    break;
+                }
+                // CPU is idle: jump straight to the next arrival or wake-up
+                int next = blocked.empty() ? arrivals.nextTime() : blocked.top().wakeTime;
+                if (arrivals.pending()) {
+                    next = std::min(next, arrivals.nextTime());
                 }
+                currentTime = std::max(currentTime, next);
+                continue;
+            }
+
+            int index = policy.pickNext(currentTime);
+            ProcessState& current = states[index];
+            metrics.recordDispatch(index, index != lastIndex && lastIndex != -1);
+            lastIndex = index;
+            if (current.startTime < 0) {
+                current.startTime = currentTime;
+            }
+
+            // Execute for the policy's slice or the remaining time
+            int executeTime = std::min(policy.timeSlice(index, current), current.remainingTime);
+            if (Policy::preemptOnArrival && arrivals.pending()) {
+                int untilArrival = arrivals.nextTime() - currentTime;
+                if (untilArrival > 0) {
+                    executeTime = std::min(executeTime, untilArrival);
+                }
+            }
+            if (Policy::preemptOnArrival && !blocked.empty()) {
+                int untilWake = blocked.top().wakeTime - currentTime;
+                if (untilWake > 0) {
+                    executeTime = std::min(executeTime, untilWake);
+                }
+            }
+            int stall = dispatchStall(onDispatch, processes[index], executeTime);
+            current.remainingTime -= executeTime;
+            currentTime += executeTime;
+
+            // A stalled process gives up the CPU until its wait is over
+            if (stall > 0) {
+                blocked.push({currentTime + stall, index, executeTime});
+            } else if (current.remainingTime > 0) {
+                policy.requeue(index, processes[index], current, executeTime, currentTime);
+            } else {
+                complete(index, currentTime);
             }
         }
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,267 @@
+#ifndef SCHEDULING_METRICS_H
+#define SCHEDULING_METRICS_H
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include "Process.h"
+
+// Log-bucketed histogram: values below 16 get exact buckets, larger values
+// get 16 linear sub-buckets per power of two (at most 6.25% relative error).
+// Recording is O(1) and two histograms can be merged bucket by bucket.
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = SUB_BUCKETS + (63 - SUB_BITS) * SUB_BUCKETS;
+
+    std::vector<long long> buckets;
+    long long count;
+    long long sum;
+    long long minValue;
+    long long maxValue;
+
+    static int bucketOf(long long value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<int>(std::max(0LL, value));
+        }
+        int exponent = 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+        int sub = static_cast<int>((value >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+        return SUB_BUCKETS + (exponent - SUB_BITS) * SUB_BUCKETS + sub;
+    }
+
+    static long long bucketLow(int bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        int exponent = (bucket - SUB_BUCKETS) / SUB_BUCKETS + SUB_BITS;
+        int sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+        return static_cast<long long>(SUB_BUCKETS + sub) << (exponent - SUB_BITS);
+    }
+
+public:
+    LatencyHistogram() : buckets(BUCKETS, 0), count(0), sum(0), minValue(0), maxValue(0) {}
+
+    void record(long long value) {
+        buckets[bucketOf(value)]++;
+        if (count == 0 || value < minValue) minValue = value;
+        if (count == 0 || value > maxValue) maxValue = value;
+        count++;
+        sum += value;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        if (other.count == 0) {
+            return;
+        }
+        for (int i = 0; i < BUCKETS; i++) {
+            buckets[i] += other.buckets[i];
+        }
+        minValue = count == 0 ? other.minValue : std::min(minValue, other.minValue);
+        maxValue = count == 0 ? other.maxValue : std::max(maxValue, other.maxValue);
+        count += other.count;
+        sum += other.sum;
+    }
+
+    void clear() {
+        std::fill(buckets.begin(), buckets.end(), 0);
+        count = sum = minValue = maxValue = 0;
+    }
+
+    long long getCount() const { return count; }
+    long long getMin() const { return minValue; }
+    long long getMax() const { return maxValue; }
+    double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+
+    // Lower bound of the bucket holding the q-th quantile, clamped to the
+    // observed range
+    long long percentile(double q) const {
+        if (count == 0) {
+            return 0;
+        }
+        long long target = std::max(1LL, static_cast<long long>(q * count + 0.999999));
+        long long seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= target) {
+                return std::min(std::max(bucketLow(i), minValue), maxValue);
+            }
+        }
+        return maxValue;
+    }
+};
+
+// Scheduling metrics updated incrementally by the scheduling loop.
+// Aggregates are always kept; per-process records are optional because
+// they cost memory proportional to the workload.
+class SchedulingMetrics {
+public:
+    struct ProcessRecord {
+        int pid;
+        int arrival;
+        int burst;
+        int start;
+        int completion;
+        int dispatches;
+    };
+
+private:
+    LatencyHistogram turnaroundTimes;
+    LatencyHistogram waitingTimes;
+    LatencyHistogram responseTimes;
+    long long contextSwitches;
+    long long slices;
+    long long makespan;
+    double slowdownSum;         // Turnaround / burst, for the fairness index
+    double slowdownSquares;
+    bool keepPerProcess;
+    std::vector<int> dispatchCount;     // Per process index, only with keepPerProcess
+    std::vector<ProcessRecord> records;
+
+public:
+    SchedulingMetrics(bool _keepPerProcess = false)
+        : contextSwitches(0), slices(0), makespan(0), slowdownSum(0.0), slowdownSquares(0.0),
+          keepPerProcess(_keepPerProcess) {}
+
+    void setKeepPerProcess(bool keep) { keepPerProcess = keep; }
+
+    void reset(std::size_t processCount) {
+        turnaroundTimes.clear();
+        waitingTimes.clear();
+        responseTimes.clear();
+        contextSwitches = slices = makespan = 0;
+        slowdownSum = slowdownSquares = 0.0;
+        records.clear();
+        if (keepPerProcess) {
+            dispatchCount.assign(processCount, 0);
+        } else {
+            dispatchCount.clear();
+        }
+    }
+
+    void recordDispatch(int index, bool contextSwitch) {
+        slices++;
+        if (contextSwitch) {
+            contextSwitches++;
+        }
+        if (keepPerProcess) {
+            if (index >= static_cast<int>(dispatchCount.size())) {
+                dispatchCount.resize(index + 1, 0);
+            }
+            dispatchCount[index]++;
+        }
+    }
+
+    void recordCompletion(int index, const Process& p, const ProcessState& s, int completionTime) {
+        long long turnaround = completionTime - p.arrivalTime;
+        turnaroundTimes.record(turnaround);
+        waitingTimes.record(turnaround - p.burstTime);
+        responseTimes.record(s.startTime - p.arrivalTime);
+        makespan = std::max(makespan, static_cast<long long>(completionTime));
+        double slowdown = static_cast<double>(turnaround) / std::max(1, p.burstTime);
+        slowdownSum += slowdown;
+        slowdownSquares += slowdown * slowdown;
+        if (keepPerProcess) {
+            int dispatches = 0;
+            if (index < static_cast<int>(dispatchCount.size())) {
+                dispatches = dispatchCount[index];
+                dispatchCount[index] = 0;   // The slot may be reused by trace replay
+            }
+            records.push_back({p.pid, p.arrivalTime, p.burstTime, s.startTime, completionTime, dispatches});
+        }
+    }
+
+    void merge(const SchedulingMetrics& other) {
+        turnaroundTimes.merge(other.turnaroundTimes);
+        waitingTimes.merge(other.waitingTimes);
+        responseTimes.merge(other.responseTimes);
+        contextSwitches += other.contextSwitches;
+        slices += other.slices;
+        makespan = std::max(makespan, other.makespan);
+        slowdownSum += other.slowdownSum;
+        slowdownSquares += other.slowdownSquares;
+        records.insert(records.end(), other.records.begin(), other.records.end());
+    }
+
+    long long completed() const { return turnaroundTimes.getCount(); }
+    long long getContextSwitches() const { return contextSwitches; }
+    long long getSlices() const { return slices; }
+    long long getMakespan() const { return makespan; }
+
+    // Jain's index over per-process slowdown: 1.0 when every process is
+    // slowed down equally, approaching 1/n as one process gets all the delay
+    double fairnessIndex() const {
+        return slowdownSquares > 0 ? slowdownSum * slowdownSum / (completed() * slowdownSquares) : 1.0;
+    }
+    const LatencyHistogram& turnaround() const { return turnaroundTimes; }
+    const LatencyHistogram& waiting() const { return waitingTimes; }
+    const LatencyHistogram& response() const { return responseTimes; }
+    const std::vector<ProcessRecord>& processRecords() const { return records; }
+
+    // Formats the whole report into one buffer and writes it once
+    void writeReport(std::ostream& out) const {
+        std::ostringstream buffer;
+
+        if (!records.empty()) {
+            buffer << std::left
+                   << std::setw(8) << "PID"
+                   << std::setw(10) << "Arrival"
+                   << std::setw(8) << "Burst"
+                   << std::setw(12) << "Completion"
+                   << std::setw(12) << "Turnaround"
+                   << std::setw(10) << "Waiting"
+                   << std::setw(10) << "Response"
+                   << "Dispatches\n";
+            buffer << "------------------------------------------------------------------------------\n";
+            for (const auto& r : records) {
+                buffer << std::left
+                       << std::setw(8) << r.pid
+                       << std::setw(10) << r.arrival
+                       << std::setw(8) << r.burst
+                       << std::setw(12) << r.completion
+                       << std::setw(12) << (r.completion - r.arrival)
+                       << std::setw(10) << (r.completion - r.arrival - r.burst)
+                       << std::setw(10) << (r.start - r.arrival)
+                       << r.dispatches << "\n";
+            }
+            buffer << "\n";
+        }
+
+        buffer << "Completed: " << completed()
+               << "  Makespan: " << makespan
+               << "  Slices: " << slices
+               << "  Context switches: " << contextSwitches
+               << "  Fairness: " << std::fixed << std::setprecision(3) << fairnessIndex() << "\n\n";
+
+        buffer << std::left
+               << std::setw(12) << ""
+               << std::setw(10) << "Mean"
+               << std::setw(10) << "p50"
+               << std::setw(10) << "p99"
+               << std::setw(10) << "p999"
+               << "Max\n";
+        writeRow(buffer, "Turnaround", turnaroundTimes);
+        writeRow(buffer, "Waiting", waitingTimes);
+        writeRow(buffer, "Response", responseTimes);
+
+        const std::string text = buffer.str();
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        out.flush();
+    }
+
+private:
+    static void writeRow(std::ostringstream& buffer, const char* label, const LatencyHistogram& h) {
+        buffer << std::left << std::setw(12) << label
+               << std::fixed << std::setprecision(2) << std::setw(10) << h.mean()
+               << std::setw(10) << h.percentile(0.50)
+               << std::setw(10) << h.percentile(0.99)
+               << std::setw(10) << h.percentile(0.999)
+               << h.getMax() << "\n";
+    }
+};
+
+#endif
@@ -0,0 +1,327 @@
+#ifndef SCHEDULING_POLICIES_H
+#define SCHEDULING_POLICIES_H
+
+#include <set>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include "Process.h"
+
+// Scheduling policies plugged into Scheduler::run<Policy>().
+//
+// Each policy is a plain class, dispatched at compile time, that provides:
+//   const char* name() const
+//   void reset(std::size_t processCount)
+//   void admit(int index, const Process& p, const ProcessState& s, int now)
+//   bool empty() const
+//   int  pickNext(int now)                                removes and returns an index
+//   int  timeSlice(int index, const ProcessState& s) const
+//   void requeue(int index, const Process& p, const ProcessState& s, int ran, int now)
+//   static constexpr bool preemptOnArrival                cut slices short at arrivals
+//
+// admit() is called when a process arrives, requeue() when it was preempted
+// after running for `ran` time units, and timeSlice() bounds the next run.
+//
+// Priorities follow the process menu: 1 is the highest, 5 the lowest.
+
+class RoundRobinPolicy {
+private:
+    std::deque<int> ready;
+    int quantum;
+
+public:
+    static constexpr bool preemptOnArrival = false;
+
+    RoundRobinPolicy(int _quantum = 2) : quantum(_quantum) {}
+
+    const char* name() const { return "Round Robin"; }
+
+    void reset(std::size_t) { ready.clear(); }
+
+    void admit(int index, const Process&, const ProcessState&, int) { ready.push_back(index); }
+
+    bool empty() const { return ready.empty(); }
+
+    int pickNext(int) {
+        int index = ready.front();
+        ready.pop_front();
+        return index;
+    }
+
+    int timeSlice(int, const ProcessState&) const { return quantum; }
+
+    void requeue(int index, const Process&, const ProcessState&, int, int) { ready.push_back(index); }
+};
+
+// Multi-Level Feedback Queue: new processes start at the top level, a process
+// that uses its whole quantum is demoted, and every boostInterval time units
+// all processes are moved back to the top to avoid starvation.
+class MLFQPolicy {
+private:
+    std::vector<std::deque<int>> levels;
+    std::vector<int> quanta;
+    std::vector<int> levelOf;   // Current level per process index
+    std::size_t readyCount;
+    int boostInterval;
+    int nextBoost;
+
+public:
+    static constexpr bool preemptOnArrival = false;
+
+    MLFQPolicy(std::vector<int> _quanta = {2, 4, 8}, int _boostInterval = 100)
+        : levels(_quanta.size()), quanta(std::move(_quanta)), readyCount(0),
+          boostInterval(_boostInterval), nextBoost(_boostInterval) {}
+
+    const char* name() const { return "MLFQ"; }
+
+    void reset(std::size_t processCount) {
+        for (auto& level : levels) {
+            level.clear();
+        }
+        levelOf.assign(processCount, 0);
+        readyCount = 0;
+        nextBoost = boostInterval;
+    }
+
+    void admit(int index, const Process&, const ProcessState&, int) {
+        if (index >= static_cast<int>(levelOf.size())) {
+            levelOf.resize(index + 1, 0);   // Trace replay grows the slot table
+        }
+        levelOf[index] = 0;
+        levels[0].push_back(index);
+        readyCount++;
+    }
+
+    bool empty() const { return readyCount == 0; }
+
+    int pickNext(int now) {
+        if (boostInterval > 0 && now >= nextBoost) {
+            boost();
+            nextBoost = now - now % boostInterval + boostInterval;
+        }
+        for (auto& level : levels) {
+            if (!level.empty()) {
+                int index = level.front();
+                level.pop_front();
+                readyCount--;
+                return index;
+            }
+        }
+        return -1;
+    }
+
+    int timeSlice(int index, const ProcessState&) const { return quanta[levelOf[index]]; }
+
+    void requeue(int index, const Process&, const ProcessState&, int ran, int) {
+        int level = levelOf[index];
+        if (ran >= quanta[level] && level + 1 < static_cast<int>(levels.size())) {
+            level++;
+        }
+        levelOf[index] = level;
+        levels[level].push_back(index);
+        readyCount++;
+    }
+
+private:
+    // Amortized over boostInterval time units
+    void boost() {
+        for (std::size_t i = 1; i < levels.size(); i++) {
+            for (int index : levels[i]) {
+                levelOf[index] = 0;
+                levels[0].push_back(index);
+            }
+            levels[i].clear();
+        }
+    }
+};
+
+// Priority scheduling with aging. A waiting process gains one priority level
+// for every agingInterval time units it spends in the ready queue. Ordering by
+// priority * agingInterval + readySince is equivalent and does not change as
+// time passes, so a single binary heap gives O(log n) selection.
+class PriorityAgingPolicy {
+private:
+    struct Entry {
+        long long key;
+        long long sequence;
+        int index;
+        bool operator>(const Entry& other) const {
+            return key != other.key ? key > other.key : sequence > other.sequence;
+        }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> ready;
+    int quantum;
+    int agingInterval;
+    long long sequence;
+
+public:
+    static constexpr bool preemptOnArrival = false;
+
+    PriorityAgingPolicy(int _quantum = 2, int _agingInterval = 10)
+        : quantum(_quantum), agingInterval(_agingInterval), sequence(0) {}
+
+    const char* name() const { return "Priority + Aging"; }
+
+    void reset(std::size_t) {
+        ready = decltype(ready)();
+        sequence = 0;
+    }
+
+    void admit(int index, const Process& p, const ProcessState&, int now) { push(index, p, now); }
+
+    bool empty() const { return ready.empty(); }
+
+    int pickNext(int) {
+        int index = ready.top().index;
+        ready.pop();
+        return index;
+    }
+
+    int timeSlice(int, const ProcessState&) const { return quantum; }
+
+    void requeue(int index, const Process& p, const ProcessState&, int, int now) { push(index, p, now); }
+
+private:
+    void push(int index, const Process& p, int now) {
+        ready.push({static_cast<long long>(p.priority) * agingInterval + now, sequence++, index});
+    }
+};
+
+// Shortest Job First. The non-preemptive form runs the shortest remaining job
+// to completion; the preemptive form (SRTF) re-evaluates at every arrival.
+template <bool Preemptive>
+class ShortestJobPolicy {
+private:
+    struct Entry {
+        int remaining;
+        long long sequence;
+        int index;
+        bool operator>(const Entry& other) const {
+            return remaining != other.remaining ? remaining > other.remaining
+                                                : sequence > other.sequence;
+        }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> ready;
+    long long sequence;
+
+public:
+    static constexpr bool preemptOnArrival = Preemptive;
+
+    ShortestJobPolicy() : sequence(0) {}
+
+    const char* name() const { return Preemptive ? "SRTF" : "SJF"; }
+
+    void reset(std::size_t) {
+        ready = decltype(ready)();
+        sequence = 0;
+    }
+
+    void admit(int index, const Process&, const ProcessState& s, int) { ready.push({s.remainingTime, sequence++, index}); }
+
+    bool empty() const { return ready.empty(); }
+
+    int pickNext(int) {
+        int index = ready.top().index;
+        ready.pop();
+        return index;
+    }
+
+    int timeSlice(int, const ProcessState& s) const { return s.remainingTime; }
+
+    void requeue(int index, const Process&, const ProcessState& s, int, int) { ready.push({s.remainingTime, sequence++, index}); }
+};
+
+using SJFPolicy = ShortestJobPolicy<false>;
+using SRTFPolicy = ShortestJobPolicy<true>;
+
+// Completely-fair style scheduling. Runnable processes are kept in a balanced
+// tree ordered by virtual runtime, which advances more slowly for heavier
+// (higher priority) processes, so pick-next and insert are O(log n). Instead
+// of a fixed quantum each slice is the process's weighted share of
+// targetLatency, never shorter than minGranularity.
+class FairSharePolicy {
+private:
+    static constexpr long long NICE_0_WEIGHT = 1024;
+    static constexpr long long VRUNTIME_SCALE = 1024;   // Fixed-point fraction bits
+
+    struct Entity {
+        long long vruntime;
+        long long weight;
+    };
+
+    std::set<std::pair<long long, int>> timeline;  // (vruntime, index)
+    std::vector<Entity> entities;                   // Per process index
+    long long minVruntime;
+    long long readyWeight;
+    int targetLatency;
+    int minGranularity;
+
+    // Priority 1..5 maps to nice -10, -5, 0, 5, 10
+    static long long weightOf(const Process& p) {
+        static const long long weights[] = {9548, 3121, 1024, 335, 110};
+        int level = std::min(std::max(p.priority, 1), 5) - 1;
+        return weights[level];
+    }
+
+public:
+    static constexpr bool preemptOnArrival = false;
+
+    FairSharePolicy(int _targetLatency = 20, int _minGranularity = 1)
+        : minVruntime(0), readyWeight(0),
+          targetLatency(_targetLatency), minGranularity(_minGranularity) {}
+
+    const char* name() const { return "Fair Share (CFS)"; }
+
+    void reset(std::size_t processCount) {
+        timeline.clear();
+        entities.assign(processCount, {0, NICE_0_WEIGHT});
+        minVruntime = 0;
+        readyWeight = 0;
+    }
+
+    // New arrivals start at the current minimum so they cannot monopolize
+    // the CPU by bringing a zero virtual runtime
+    void admit(int index, const Process& p, const ProcessState&, int) {
+        if (index >= static_cast<int>(entities.size())) {
+            entities.resize(index + 1, {0, NICE_0_WEIGHT});
+        }
+        entities[index] = {minVruntime, weightOf(p)};
+        insert(index);
+    }
+
+    bool empty() const { return timeline.empty(); }
+
+    int pickNext(int) {
+        auto first = timeline.begin();
+        int index = first->second;
+        minVruntime = std::max(minVruntime, first->first);
+        readyWeight -= entities[index].weight;
+        timeline.erase(first);
+        return index;
+    }
+
+    // The running process is still runnable, so it counts toward the total
+    int timeSlice(int index, const ProcessState&) const {
+        long long weight = entities[index].weight;
+        long long share = targetLatency * weight / (readyWeight + weight);
+        return static_cast<int>(std::max<long long>(minGranularity, share));
+    }
+
+    void requeue(int index, const Process&, const ProcessState&, int ran, int) {
+        Entity& entity = entities[index];
+        entity.vruntime += ran * NICE_0_WEIGHT * VRUNTIME_SCALE / entity.weight;
+        insert(index);
+    }
+
+private:
+    void insert(int index) {
+        timeline.emplace(entities[index].vruntime, index);
+        readyWeight += entities[index].weight;
+    }
+};
+
+#endif
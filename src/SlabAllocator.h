@@ -0,0 +1,287 @@
+#ifndef SLAB_ALLOCATOR_H
+#define SLAB_ALLOCATOR_H
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "MemoryAllocator.h"
+#include "MemoryManager.h"
+
+struct SlabClassStats {
+    int objectSize = 0;
+    int slabs = 0;
+    int slots = 0;
+    int usedSlots = 0;
+
+    double utilization() const {
+        return slots > 0 ? static_cast<double>(usedSlots) / slots : 0.0;
+    }
+};
+
+// Size-class allocator layered over a general-purpose backend.
+//
+// Requests up to the largest size class are rounded up to a class and served
+// from slabs: fixed-size runs of slabSize carved from the backend, each split
+// into equal slots tracked by a free-slot bitmap. Allocating and freeing a
+// slot are bit operations. The backend is only called when a class has no
+// slab with a free slot, or when a slab empties out. Larger requests go
+// straight to the backend. Slabs are indexed by start address, so the backend
+// must not relocate blocks and a compacting MemoryManager cannot be used.
+class SlabAllocator : public MemoryAllocator {
+private:
+    struct Slab {
+        int start = 0;
+        int sizeClass = -1;         // -1 while the slab id is unused
+        int slotCount = 0;
+        int freeSlots = 0;
+        int partialPos = -1;        // Position in partialSlabs, -1 when full
+        std::vector<uint64_t> freeBits;
+        std::vector<int> requested; // Per slot, for internal fragmentation
+    };
+
+    std::unique_ptr<MemoryAllocator> backing;
+    std::string label;
+    std::vector<int> sizeClasses;               // Ascending object sizes
+    int slabSize;
+    std::vector<Slab> slabs;
+    std::vector<int> unusedSlabIds;
+    std::vector<std::vector<int>> partialSlabs; // [class] slabs with a free slot
+    std::vector<int> slabAt;                    // [start / slabSize] slab id, or -1
+    std::unordered_map<int, int> largeBlocks;   // start -> requested size
+    int requestedMemory;
+    int smallObjects;
+
+public:
+    SlabAllocator(std::unique_ptr<MemoryAllocator> _backing,
+                  std::vector<int> _sizeClasses = {1, 2, 4, 8, 16},
+                  int _slabSize = 64)
+        : backing(std::move(_backing)), label(std::string("Slab over ") + backing->name()),
+          sizeClasses(std::move(_sizeClasses)),
+          slabSize(std::max(1, _slabSize)), requestedMemory(0), smallObjects(0) {
+        std::sort(sizeClasses.begin(), sizeClasses.end());
+        sizeClasses.erase(std::remove_if(sizeClasses.begin(), sizeClasses.end(),
+                                         [this](int size) { return size <= 0 || size > slabSize; }),
+                          sizeClasses.end());
+        sizeClasses.erase(std::unique(sizeClasses.begin(), sizeClasses.end()), sizeClasses.end());
+        partialSlabs.resize(sizeClasses.size());
+        slabAt.assign(backing->getStats().totalMemory / slabSize + 1, -1);
+    }
+
+    SlabAllocator(int totalSize = 1024)
+        : SlabAllocator(std::unique_ptr<MemoryAllocator>(new MemoryManager(totalSize))) {}
+
+    const char* name() const override { return label.c_str(); }
+
+    int allocateMemory(int size, const std::string& processName) override {
+        if (size <= 0) {
+            return -1;
+        }
+        int sizeClass = classFor(size);
+        if (sizeClass < 0) {
+            int start = backing->allocateMemory(size, processName);
+            if (start >= 0) {
+                largeBlocks[start] = size;
+                requestedMemory += size;
+            }
+            return start;
+        }
+
+        std::vector<int>& partial = partialSlabs[sizeClass];
+        if (partial.empty() && !growClass(sizeClass)) {
+            return -1; // Allocation failed
+        }
+        Slab& slab = slabs[partial.back()];
+
+        int word = 0;
+        while (slab.freeBits[word] == 0) {
+            word++;
+        }
+        int slot = word * 64 + __builtin_ctzll(slab.freeBits[word]);
+        slab.freeBits[word] &= slab.freeBits[word] - 1;
+        slab.requested[slot] = size;
+        if (--slab.freeSlots == 0) {
+            removePartial(slab);
+        }
+
+        smallObjects++;
+        requestedMemory += size;
+        return slab.start + slot * sizeClasses[sizeClass];
+    }
+
+    bool deallocateMemory(int startAddress) override {
+        int id = slabContaining(startAddress);
+        if (id < 0) {
+            auto it = largeBlocks.find(startAddress);
+            if (it == largeBlocks.end() || !backing->deallocateMemory(startAddress)) {
+                return false;
+            }
+            requestedMemory -= it->second;
+            largeBlocks.erase(it);
+            return true;
+        }
+
+        Slab& slab = slabs[id];
+        int objectSize = sizeClasses[slab.sizeClass];
+        int offset = startAddress - slab.start;
+        int slot = offset / objectSize;
+        if (offset % objectSize != 0 || slot >= slab.slotCount) {
+            return false;
+        }
+        uint64_t bit = uint64_t(1) << (slot & 63);
+        if (slab.freeBits[slot >> 6] & bit) {
+            return false; // Already free
+        }
+        slab.freeBits[slot >> 6] |= bit;
+        requestedMemory -= slab.requested[slot];
+        smallObjects--;
+
+        if (slab.freeSlots++ == 0) {
+            addPartial(slab, id);
+        }
+        // Give an empty slab back unless it is the class's last spare slot
+        if (slab.freeSlots == slab.slotCount && partialSlabs[slab.sizeClass].size() > 1) {
+            releaseSlab(id);
+        }
+        return true;
+    }
+
+    void displayMemoryMap() override {
+        backing->displayMemoryMap();
+        displaySlabReport();
+    }
+
+    void displaySlabReport() const {
+        std::cout << "\n=== Slab Utilization ===\n";
+        std::cout << std::left
+                  << std::setw(12) << "Object Size"
+                  << std::setw(8) << "Slabs"
+                  << std::setw(8) << "Slots"
+                  << std::setw(8) << "Used"
+                  << "Utilization\n";
+        std::cout << "---------------------------------------------\n";
+        std::cout << std::fixed << std::setprecision(1);
+        for (const SlabClassStats& cls : getSlabStats()) {
+            std::cout << std::left
+                      << std::setw(12) << cls.objectSize
+                      << std::setw(8) << cls.slabs
+                      << std::setw(8) << cls.slots
+                      << std::setw(8) << cls.usedSlots
+                      << cls.utilization() * 100 << "%\n";
+        }
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    std::vector<SlabClassStats> getSlabStats() const {
+        std::vector<SlabClassStats> stats(sizeClasses.size());
+        for (std::size_t c = 0; c < sizeClasses.size(); c++) {
+            stats[c].objectSize = sizeClasses[c];
+        }
+        for (const Slab& slab : slabs) {
+            if (slab.sizeClass < 0) {
+                continue;
+            }
+            SlabClassStats& cls = stats[slab.sizeClass];
+            cls.slabs++;
+            cls.slots += slab.slotCount;
+            cls.usedSlots += slab.slotCount - slab.freeSlots;
+        }
+        return stats;
+    }
+
+    // Slabs count as allocated in full, so unused slots show up as internal
+    // fragmentation
+    MemoryStats getStats() const override {
+        MemoryStats stats = backing->getStats();
+        int slabCount = 0;
+        for (const Slab& slab : slabs) {
+            if (slab.sizeClass >= 0) {
+                slabCount++;
+            }
+        }
+        stats.allocatedBlocks += smallObjects - slabCount;
+        stats.requestedMemory = requestedMemory;
+        return stats;
+    }
+
+private:
+    int classFor(int size) const {
+        auto it = std::lower_bound(sizeClasses.begin(), sizeClasses.end(), size);
+        return it == sizeClasses.end() ? -1 : static_cast<int>(it - sizeClasses.begin());
+    }
+
+    // A slab covers [start, start + slabSize), so only the buckets for
+    // address and address - slabSize can hold it
+    int slabContaining(int address) const {
+        int bucket = address / slabSize;
+        for (int b = bucket; b >= 0 && b >= bucket - 1; b--) {
+            if (b >= static_cast<int>(slabAt.size())) {
+                continue;
+            }
+            int id = slabAt[b];
+            if (id >= 0 && address >= slabs[id].start && address < slabs[id].start + slabSize) {
+                return id;
+            }
+        }
+        return -1;
+    }
+
+    bool growClass(int sizeClass) {
+        int start = backing->allocateMemory(slabSize, "slab:" + std::to_string(sizeClasses[sizeClass]));
+        if (start < 0) {
+            return false;
+        }
+
+        int id;
+        if (!unusedSlabIds.empty()) {
+            id = unusedSlabIds.back();
+            unusedSlabIds.pop_back();
+        } else {
+            id = static_cast<int>(slabs.size());
+            slabs.emplace_back();
+        }
+        Slab& slab = slabs[id];
+        slab.start = start;
+        slab.sizeClass = sizeClass;
+        slab.slotCount = slabSize / sizeClasses[sizeClass];
+        slab.freeSlots = slab.slotCount;
+        slab.freeBits.assign((slab.slotCount + 63) / 64, ~uint64_t(0));
+        if (slab.slotCount % 64 != 0) {
+            slab.freeBits.back() = (uint64_t(1) << (slab.slotCount % 64)) - 1;
+        }
+        slab.requested.assign(slab.slotCount, 0);
+        slabAt[start / slabSize] = id;
+        addPartial(slab, id);
+        return true;
+    }
+
+    void releaseSlab(int id) {
+        Slab& slab = slabs[id];
+        removePartial(slab);
+        slabAt[slab.start / slabSize] = -1;
+        backing->deallocateMemory(slab.start);
+        slab.sizeClass = -1;
+        unusedSlabIds.push_back(id);
+    }
+
+    void addPartial(Slab& slab, int id) {
+        std::vector<int>& partial = partialSlabs[slab.sizeClass];
+        slab.partialPos = static_cast<int>(partial.size());
+        partial.push_back(id);
+    }
+
+    void removePartial(Slab& slab) {
+        std::vector<int>& partial = partialSlabs[slab.sizeClass];
+        int last = partial.back();
+        partial[slab.partialPos] = last;
+        slabs[last].partialPos = slab.partialPos;
+        partial.pop_back();
+        slab.partialPos = -1;
+    }
+};
+
+#endif
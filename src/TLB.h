@@ -0,0 +1,161 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "PageReplacement.h"
+
+enum class TLBReplacement {
+    LRU,
+    RANDOM
+};
+
+struct TLBConfig {
+    int entries = 64;
+    int ways = 4;                   // entries == ways gives a fully associative TLB
+    TLBReplacement replacement = TLBReplacement::LRU;
+    bool asidTagging = true;        // false flushes the whole TLB on every context switch
+};
+
+struct TLBStats {
+    long long lookups = 0;
+    long long hits = 0;
+    long long misses = 0;
+    long long contextSwitches = 0;
+    long long flushes = 0;
+    long long invalidations = 0;    // Single entries dropped because their page was evicted
+
+    double hitRate() const {
+        return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+    }
+};
+
+// Set-associative translation cache in front of the page tables. Each slot
+// caches a pointer to the page's entry, so a hit can still set referenced
+// and dirty bits without walking the tables. Slots are tagged with the
+// owning address space; without ASID tagging, a context switch flushes
+// everything instead.
+class TLB {
+private:
+    TLBConfig config;
+    int sets;
+    std::vector<int> pages;             // [set * ways + way]
+    std::vector<int> asids;
+    std::vector<PageTableEntry*> slots; // nullptr when the slot is empty
+    std::vector<uint64_t> lastUse;
+    uint64_t useClock = 0;
+    uint32_t randomState = 2463534242u;
+    int currentAsid = -1;
+    TLBStats stats;
+
+    int firstSlot(int pageNumber) const {
+        return static_cast<int>(static_cast<unsigned>(pageNumber) % static_cast<unsigned>(sets)) * config.ways;
+    }
+
+    // xorshift32; only needs to be cheap and reproducible
+    uint32_t nextRandom() {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
+
+    int chooseVictim(int base) {
+        for (int way = 0; way < config.ways; way++) {
+            if (slots[base + way] == nullptr) {
+                return base + way;
+            }
+        }
+        if (config.replacement == TLBReplacement::RANDOM) {
+            return base + static_cast<int>(nextRandom() % static_cast<uint32_t>(config.ways));
+        }
+        int victim = base;
+        for (int way = 1; way < config.ways; way++) {
+            if (lastUse[base + way] < lastUse[victim]) {
+                victim = base + way;
+            }
+        }
+        return victim;
+    }
+
+public:
+    explicit TLB(TLBConfig _config = TLBConfig()) : config(_config) {
+        config.ways = std::max(1, config.ways);
+        sets = std::max(1, config.entries / config.ways);
+        config.entries = sets * config.ways;
+        pages.assign(config.entries, -1);
+        asids.assign(config.entries, -1);
+        slots.assign(config.entries, nullptr);
+        lastUse.assign(config.entries, 0);
+    }
+
+    const TLBConfig& getConfig() const { return config; }
+    const TLBStats& getStats() const { return stats; }
+    void resetStats() { stats = TLBStats(); }
+
+    // Cached entry for the page in the given address space, or nullptr
+    PageTableEntry* lookup(int asid, int pageNumber) {
+        stats.lookups++;
+        int base = firstSlot(pageNumber);
+        for (int slot = base; slot < base + config.ways; slot++) {
+            if (slots[slot] != nullptr && pages[slot] == pageNumber && asids[slot] == asid) {
+                stats.hits++;
+                lastUse[slot] = ++useClock;
+                return slots[slot];
+            }
+        }
+        stats.misses++;
+        return nullptr;
+    }
+
+    // Caches a translation after a miss
+    void insert(int asid, int pageNumber, PageTableEntry* entry) {
+        int slot = chooseVictim(firstSlot(pageNumber));
+        pages[slot] = pageNumber;
+        asids[slot] = asid;
+        slots[slot] = entry;
+        lastUse[slot] = ++useClock;
+    }
+
+    // Drops the translation of a page that is no longer resident
+    void invalidate(int asid, int pageNumber) {
+        int base = firstSlot(pageNumber);
+        for (int slot = base; slot < base + config.ways; slot++) {
+            if (slots[slot] != nullptr && pages[slot] == pageNumber && asids[slot] == asid) {
+                slots[slot] = nullptr;
+                stats.invalidations++;
+                return;
+            }
+        }
+    }
+
+    // Drops every translation of one address space
+    void invalidateAsid(int asid) {
+        for (int slot = 0; slot < config.entries; slot++) {
+            if (asids[slot] == asid) {
+                slots[slot] = nullptr;
+            }
+        }
+    }
+
+    void flush() {
+        std::fill(slots.begin(), slots.end(), nullptr);
+        stats.flushes++;
+    }
+
+    void contextSwitch(int asid) {
+        if (asid == currentAsid) {
+            return;
+        }
+        if (currentAsid != -1) {
+            stats.contextSwitches++;
+            if (!config.asidTagging) {
+                flush();
+            }
+        }
+        currentAsid = asid;
+    }
+};
+
+#endif
@@ -0,0 +1,331 @@
+#ifndef TRACE_READER_H
+#define TRACE_READER_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <iostream>
+#include "Process.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// One workload record: (pid, name, priority, burst, arrival)
+struct TraceRecord {
+    int32_t pid;
+    int32_t priority;
+    int32_t burstTime;
+    int32_t arrivalTime;
+    char name[16];          // NUL padded, truncated to 15 characters
+
+    Process toProcess() const {
+        return Process(pid, std::string(name, strnlen(name, sizeof(name))), priority, burstTime, arrivalTime);
+    }
+};
+
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord must stay 32 bytes on disk");
+
+// Streams workload records out of a memory-mapped trace file.
+//
+// Two formats are accepted:
+//   CSV     one "pid,name,priority,burst,arrival" line per process; a first
+//           line that does not start with a digit is treated as a header
+//   Binary  the 8-byte magic "OSTRACE1", a uint64 record count, then packed
+//           32-byte TraceRecords in host byte order
+//
+// Records are parsed one at a time straight from the mapping, so a trace is
+// never materialized as Process objects. Traces are expected to be sorted by
+// arrival time; the scheduler admits out-of-order records late. Records with
+// a non-positive burst, a negative arrival or an integer outside int32 are
+// skipped and counted as malformed, in either format.
+class TraceReader {
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t offset;
+    bool binary;
+    bool hasPeeked;
+    TraceRecord peeked;
+    long long malformedLines;
+#ifdef _WIN32
+    std::vector<char> buffer;   // No mmap: the file is read into memory instead
+#else
+    int fd;
+#endif
+
+public:
+    static constexpr char MAGIC[8] = {'O', 'S', 'T', 'R', 'A', 'C', 'E', '1'};
+    static constexpr std::size_t HEADER_SIZE = 16;
+
+    TraceReader()
+        : data(nullptr), size(0), offset(0), binary(false), hasPeeked(false),
+          peeked(), malformedLines(0)
+#ifndef _WIN32
+        , fd(-1)
+#endif
+    {}
+
+    ~TraceReader() {
+        close();
+    }
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return false;
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close();
+                return false;
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+#endif
+        binary = size >= HEADER_SIZE && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+        offset = binary ? HEADER_SIZE : 0;
+        if (!binary) {
+            skipCsvHeader();
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+        data = nullptr;
+        size = offset = 0;
+        hasPeeked = false;
+        malformedLines = 0;
+    }
+
+    bool isBinary() const { return binary; }
+    long long getMalformedLines() const { return malformedLines; }
+
+    // Record count of a binary trace, -1 for CSV
+    long long declaredCount() const {
+        if (!binary) {
+            return -1;
+        }
+        uint64_t count;
+        std::memcpy(&count, data + sizeof(MAGIC), sizeof(count));
+        return static_cast<long long>(count);
+    }
+
+    bool peek(TraceRecord& record) {
+        if (!hasPeeked) {
+            hasPeeked = parseNext(peeked);
+            if (!hasPeeked) {
+                return false;
+            }
+        }
+        record = peeked;
+        return true;
+    }
+
+    bool next(TraceRecord& record) {
+        if (hasPeeked) {
+            record = peeked;
+            hasPeeked = false;
+            return true;
+        }
+        return parseNext(record);
+    }
+
+    // Streams a CSV trace into the binary format. Returns records written,
+    // or -1 if either file could not be opened.
+    static long long convertCsvToBinary(const std::string& csvPath, const std::string& binaryPath) {
+        TraceReader reader;
+        if (!reader.open(csvPath)) {
+            return -1;
+        }
+        std::FILE* out = std::fopen(binaryPath.c_str(), "wb");
+        if (out == nullptr) {
+            return -1;
+        }
+
+        uint64_t count = 0;
+        std::fwrite(MAGIC, 1, sizeof(MAGIC), out);
+        std::fwrite(&count, sizeof(count), 1, out);
+
+        std::vector<TraceRecord> batch;
+        batch.reserve(4096);
+        TraceRecord record;
+        while (reader.next(record)) {
+            batch.push_back(record);
+            if (batch.size() == batch.capacity()) {
+                std::fwrite(batch.data(), sizeof(TraceRecord), batch.size(), out);
+                count += batch.size();
+                batch.clear();
+            }
+        }
+        std::fwrite(batch.data(), sizeof(TraceRecord), batch.size(), out);
+        count += batch.size();
+
+        // Patch the record count into the header
+        std::fseek(out, sizeof(MAGIC), SEEK_SET);
+        std::fwrite(&count, sizeof(count), 1, out);
+        std::fclose(out);
+        return static_cast<long long>(count);
+    }
+
+private:
+    bool parseNext(TraceRecord& record) {
+        if (binary) {
+            while (offset + sizeof(TraceRecord) <= size) {
+                std::memcpy(&record, data + offset, sizeof(TraceRecord));
+                offset += sizeof(TraceRecord);
+                if (isValid(record)) {
+                    return true;
+                }
+                malformedLines++;
+            }
+            return false;
+        }
+
+        while (offset < size) {
+            if (parseCsvLine(record)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void skipCsvHeader() {
+        std::size_t i = offset;
+        while (i < size && (data[i] == ' ' || data[i] == '\t')) {
+            i++;
+        }
+        if (i < size && (data[i] < '0' || data[i] > '9') && data[i] != '-') {
+            skipLine();
+        }
+    }
+
+    void skipLine() {
+        const void* newline = std::memchr(data + offset, '\n', size - offset);
+        offset = newline ? static_cast<const char*>(newline) - data + 1 : size;
+    }
+
+    // Parses one line in place; blank and malformed lines are skipped
+    bool parseCsvLine(TraceRecord& record) {
+        std::size_t lineStart = offset;
+        const void* newline = std::memchr(data + offset, '\n', size - offset);
+        std::size_t lineEnd = newline ? static_cast<const char*>(newline) - data : size;
+        offset = newline ? lineEnd + 1 : size;
+
+        const char* p = data + lineStart;
+        const char* end = data + lineEnd;
+        while (end > p && (end[-1] == '\r' || end[-1] == ' ')) {
+            end--;
+        }
+        if (p == end) {
+            return false;
+        }
+
+        std::memset(&record, 0, sizeof(record));
+        const char* nameStart;
+        const char* nameEnd;
+        if (!parseInt(p, end, record.pid) ||
+            !parseField(p, end, nameStart, nameEnd) ||
+            !parseInt(p, end, record.priority) ||
+            !parseInt(p, end, record.burstTime) ||
+            !parseInt(p, end, record.arrivalTime) ||
+            !isValid(record)) {
+            malformedLines++;
+            return false;
+        }
+        std::size_t nameLength = std::min<std::size_t>(nameEnd - nameStart, sizeof(record.name) - 1);
+        std::memcpy(record.name, nameStart, nameLength);
+        return true;
+    }
+
+    // A process needs some CPU time and cannot arrive before time 0
+    static bool isValid(const TraceRecord& record) {
+        return record.burstTime > 0 && record.arrivalTime >= 0;
+    }
+
+    static bool parseField(const char*& p, const char* end, const char*& start, const char*& stop) {
+        start = p;
+        while (p < end && *p != ',') {
+            p++;
+        }
+        stop = p;
+        if (p < end) {
+            p++;
+        }
+        return true;
+    }
+
+    static bool parseInt(const char*& p, const char* end, int32_t& value) {
+        while (p < end && *p == ' ') {
+            p++;
+        }
+        bool negative = p < end && *p == '-';
+        if (negative) {
+            p++;
+        }
+        if (p == end || *p < '0' || *p > '9') {
+            return false;
+        }
+        long long result = 0;
+        while (p < end && *p >= '0' && *p <= '9' && result <= 0x7fffffff) {
+            result = result * 10 + (*p - '0');
+            p++;
+        }
+        if (result > (negative ? 0x80000000LL : 0x7fffffffLL)) {
+            return false;
+        }
+        while (p < end && *p == ' ') {
+            p++;
+        }
+        if (p < end) {
+            if (*p != ',') {
+                return false;
+            }
+            p++;
+        }
+        value = static_cast<int32_t>(negative ? -result : result);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,542 @@
+#ifndef VIRTUAL_DISK_H
+#define VIRTUAL_DISK_H
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <condition_variable>
+#include "DiskScheduler.h"
+
+// POSIX only; unlike TraceReader there is no _WIN32 path, so main.cpp
+// does not include this header
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define VIRTUAL_DISK_IO_URING 1
+#endif
+#endif
+
+// One block transfer. buffer must hold blockSize bytes, aligned to the
+// block size when the disk was opened for direct I/O.
+struct BlockIO {
+    long long block;
+    bool isWrite;
+    void* buffer;
+    int result = 0;             // Bytes transferred, or -errno
+    long long latencyNs = 0;    // From taking a queue slot to completion, on either backend
+};
+
+struct VirtualDiskConfig {
+    int blockSize = 4096;
+    int blocksPerTrack = 16;    // Track t holds blocks [t * blocksPerTrack, (t + 1) * blocksPerTrack)
+    int queueDepth = 32;        // Requests in flight at once
+    bool useIoUring = true;     // Otherwise, or if io_uring is unavailable, a pread/pwrite thread pool
+    bool directIO = false;      // O_DIRECT, so transfers bypass the page cache
+};
+
+struct VirtualDiskStats {
+    long long batches = 0;
+    long long requests = 0;
+    long long bytes = 0;
+    long long errors = 0;
+    double seconds = 0.0;       // Wall time inside submitBatch
+
+    double iops() const { return seconds > 0 ? requests / seconds : 0.0; }
+    double megabytesPerSecond() const { return seconds > 0 ? bytes / seconds / 1e6 : 0.0; }
+};
+
+// Maps disk blocks onto a local image file and runs batches of block
+// transfers with asynchronous I/O, keeping up to queueDepth in flight.
+// Requests are submitted in batch order, so the order chosen by a
+// DiskScheduler (see orderBatch) reaches the device, which can then be
+// timed against FIFO order on real storage.
+class VirtualDisk {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    int fd;
+    long long blockCount;
+    VirtualDiskConfig config;
+    bool direct;
+    VirtualDiskStats stats;
+
+    static long long since(Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    long long offsetOf(const BlockIO& io) const { return io.block * config.blockSize; }
+
+    int transfer(BlockIO& io) const {
+        if (io.block < 0 || io.block >= blockCount) {
+            return -EINVAL;
+        }
+        ssize_t done = io.isWrite ? pwrite(fd, io.buffer, config.blockSize, offsetOf(io))
+                                  : pread(fd, io.buffer, config.blockSize, offsetOf(io));
+        return done < 0 ? -errno : static_cast<int>(done);
+    }
+
+    // Worker threads, each issuing blocking pread/pwrite. Workers claim
+    // requests in batch order through a shared cursor, so queueDepth
+    // workers keep up to queueDepth requests in flight. run() returns only
+    // once every worker has left the batch, and a worker that wakes after
+    // that finds no batch and goes back to sleep.
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        std::vector<BlockIO>* batch = nullptr;     // Null between runs
+        const VirtualDisk* disk = nullptr;
+        std::atomic<std::size_t> cursor{0};
+        std::size_t remaining = 0;
+        int active = 0;                             // Workers inside the batch
+        uint64_t generation = 0;
+        bool stopping = false;
+
+        void work() {
+            uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                if (batch == nullptr) {
+                    continue;
+                }
+                std::vector<BlockIO>& requests = *batch;
+                const VirtualDisk& owner = *disk;
+                active++;
+                lock.unlock();
+                std::size_t done = 0;
+                std::size_t i;
+                while ((i = cursor.fetch_add(1)) < requests.size()) {
+                    Clock::time_point issued = Clock::now();
+                    requests[i].result = owner.transfer(requests[i]);
+                    requests[i].latencyNs = since(issued);
+                    done++;
+                }
+                lock.lock();
+                remaining -= done;
+                active--;
+                if (remaining == 0 && active == 0) {
+                    finished.notify_all();
+                }
+            }
+        }
+
+    public:
+        explicit ThreadPool(int threads) {
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([this] { work(); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        void run(const VirtualDisk& owner, std::vector<BlockIO>& requests) {
+            std::unique_lock<std::mutex> lock(mutex);
+            batch = &requests;
+            disk = &owner;
+            cursor = 0;
+            remaining = requests.size();
+            generation++;
+            wake.notify_all();
+            finished.wait(lock, [&] { return remaining == 0 && active == 0; });
+            batch = nullptr;
+            disk = nullptr;
+        }
+    };
+
+#ifdef VIRTUAL_DISK_IO_URING
+    // io_uring through the raw system calls, so no liburing is needed
+    class Ring {
+    private:
+        int ringFd = -1;
+        void* sqMap = MAP_FAILED;
+        void* cqMap = MAP_FAILED;
+        std::size_t sqMapSize = 0;
+        std::size_t cqMapSize = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        std::size_t sqesSize = 0;
+        unsigned* sqHead = nullptr;
+        unsigned* sqTail = nullptr;
+        unsigned sqMask = 0;
+        unsigned* sqArray = nullptr;
+        unsigned* cqHead = nullptr;
+        unsigned* cqTail = nullptr;
+        unsigned cqMask = 0;
+        io_uring_cqe* cqes = nullptr;
+        unsigned entries = 0;
+
+    public:
+        bool open(unsigned depth) {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            ringFd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+            if (ringFd < 0) {
+                return false;
+            }
+            entries = params.sq_entries;
+            sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single) {
+                sqMapSize = cqMapSize = std::max(sqMapSize, cqMapSize);
+            }
+            sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd, IORING_OFF_SQ_RING);
+            cqMap = single ? sqMap
+                           : mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                  ringFd, IORING_OFF_CQ_RING);
+            sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                                   MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+            if (sqMap == MAP_FAILED || cqMap == MAP_FAILED || sqes == MAP_FAILED) {
+                close();
+                return false;
+            }
+            char* sq = static_cast<char*>(sqMap);
+            char* cq = static_cast<char*>(cqMap);
+            sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        void close() {
+            if (sqes != MAP_FAILED) {
+                munmap(sqes, sqesSize);
+            }
+            if (cqMap != MAP_FAILED && cqMap != sqMap) {
+                munmap(cqMap, cqMapSize);
+            }
+            if (sqMap != MAP_FAILED) {
+                munmap(sqMap, sqMapSize);
+            }
+            if (ringFd >= 0) {
+                ::close(ringFd);
+            }
+            ringFd = -1;
+            sqMap = cqMap = MAP_FAILED;
+            sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        }
+
+        ~Ring() { close(); }
+
+        unsigned capacity() const { return entries; }
+
+        // Queues one vectored read or write; user is returned with its completion
+        void prepare(int fd, const iovec* iov, long long offset, bool isWrite, uint64_t user) {
+            unsigned tail = *sqTail;
+            unsigned slot = tail & sqMask;
+            io_uring_sqe& sqe = sqes[slot];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = isWrite ? IORING_OP_WRITEV : IORING_OP_READV;
+            sqe.fd = fd;
+            sqe.off = static_cast<uint64_t>(offset);
+            sqe.addr = reinterpret_cast<uint64_t>(iov);
+            sqe.len = 1;
+            sqe.user_data = user;
+            sqArray[slot] = slot;
+            __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        }
+
+        // Submits queued entries and waits for at least waitFor completions
+        int enter(unsigned submit, unsigned waitFor) {
+            long done = syscall(__NR_io_uring_enter, ringFd, submit, waitFor,
+                                waitFor > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            return done < 0 ? -errno : static_cast<int>(done);
+        }
+
+        // Takes back entries the kernel has not consumed yet, calling
+        // fn(user) for each. Without SQPOLL the kernel only consumes entries
+        // inside io_uring_enter, so this is safe between calls.
+        template <typename Fn>
+        unsigned withdraw(Fn fn) {
+            unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+            unsigned tail = *sqTail;
+            for (unsigned i = head; i != tail; i++) {
+                fn(sqes[sqArray[i & sqMask]].user_data);
+            }
+            __atomic_store_n(sqTail, head, __ATOMIC_RELEASE);
+            return tail - head;
+        }
+
+        // Calls fn(user, result) for every available completion
+        template <typename Fn>
+        unsigned reap(Fn fn) {
+            unsigned head = *cqHead;
+            unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            unsigned count = 0;
+            for (; head != tail; head++, count++) {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                fn(cqe.user_data, cqe.res);
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+            return count;
+        }
+    };
+
+    Ring ring;
+    bool ringReady = false;
+
+    // Returns false if io_uring_enter failed. Requests the kernel had not
+    // taken get the error; those it had are waited for, since it may still
+    // be using their buffers and iovecs.
+    bool runRing(std::vector<BlockIO>& batch) {
+        std::size_t n = batch.size();
+        std::vector<iovec> iov(n);
+        std::vector<Clock::time_point> issued(n);
+        unsigned depth = std::min<unsigned>(ring.capacity(), static_cast<unsigned>(config.queueDepth));
+        std::size_t next = 0, completed = 0;
+        unsigned inFlight = 0, unsubmitted = 0;
+        int error = 0;
+        auto complete = [&](uint64_t user, int result) {
+            batch[user].result = result;
+            batch[user].latencyNs = since(issued[user]);
+        };
+        while (completed < n && error == 0) {
+            while (inFlight < depth && next < n) {
+                BlockIO& io = batch[next];
+                if (io.block < 0 || io.block >= blockCount) {
+                    io.result = -EINVAL;
+                    next++;
+                    completed++;
+                    continue;
+                }
+                iov[next].iov_base = io.buffer;
+                iov[next].iov_len = static_cast<std::size_t>(config.blockSize);
+                issued[next] = Clock::now();
+                ring.prepare(fd, &iov[next], offsetOf(io), io.isWrite, next);
+                next++;
+                inFlight++;
+                unsubmitted++;
+            }
+            if (inFlight == 0) {
+                continue;
+            }
+            int entered = ring.enter(unsubmitted, 1);
+            if (entered < 0 && entered != -EINTR && entered != -EAGAIN && entered != -EBUSY) {
+                error = entered;
+                break;
+            }
+            if (entered > 0) {
+                unsubmitted -= std::min(unsubmitted, static_cast<unsigned>(entered));
+            }
+            unsigned reaped = ring.reap(complete);
+            inFlight -= reaped;
+            completed += reaped;
+        }
+        if (error == 0) {
+            return true;
+        }
+
+        inFlight -= ring.withdraw([&](uint64_t user) { batch[user].result = error; });
+        for (std::size_t i = next; i < n; i++) {
+            batch[i].result = error;
+        }
+        // Entries already taken complete without another io_uring_enter
+        // once the kernel gets to them, so poll the completion ring
+        while (inFlight > 0) {
+            unsigned reaped = ring.reap(complete);
+            inFlight -= reaped;
+            if (reaped == 0 && ring.enter(0, 1) < 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return false;
+    }
+#endif
+
+    std::unique_ptr<ThreadPool> pool;
+
+public:
+    VirtualDisk() : fd(-1), blockCount(0), direct(false) {}
+
+    ~VirtualDisk() {
+        close();
+    }
+
+    VirtualDisk(const VirtualDisk&) = delete;
+    VirtualDisk& operator=(const VirtualDisk&) = delete;
+
+    // Opens or creates the image, growing it to blocks blocks if needed
+    bool open(const std::string& path, long long blocks, VirtualDiskConfig _config = VirtualDiskConfig()) {
+        close();
+        config = _config;
+        config.queueDepth = std::max(1, config.queueDepth);
+        blockCount = blocks;
+        direct = false;
+#ifdef O_DIRECT
+        if (config.directIO) {
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_DIRECT, 0644);
+            direct = fd >= 0;
+        }
+#endif
+        if (fd < 0) {
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        }
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        long long bytes = blocks * config.blockSize;
+        if (fstat(fd, &st) != 0 || (st.st_size < bytes && ftruncate(fd, bytes) != 0)) {
+            close();
+            return false;
+        }
+
+#ifdef VIRTUAL_DISK_IO_URING
+        ringReady = config.useIoUring && ring.open(static_cast<unsigned>(config.queueDepth));
+        if (!ringReady)
+#endif
+        {
+            pool.reset(new ThreadPool(config.queueDepth));
+        }
+        return true;
+    }
+
+    void close() {
+        pool.reset();
+#ifdef VIRTUAL_DISK_IO_URING
+        ring.close();
+        ringReady = false;
+#endif
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    bool isOpen() const { return fd >= 0; }
+    bool isDirect() const { return direct; }
+    long long getBlockCount() const { return blockCount; }
+    const VirtualDiskConfig& getConfig() const { return config; }
+
+    const char* backendName() const {
+#ifdef VIRTUAL_DISK_IO_URING
+        if (ringReady) {
+            return "io_uring";
+        }
+#endif
+        return "pread/pwrite thread pool";
+    }
+
+    int trackOf(long long block) const { return static_cast<int>(block / config.blocksPerTrack); }
+    int trackCount() const { return static_cast<int>((blockCount + config.blocksPerTrack - 1) / config.blocksPerTrack); }
+
+    // Reorders batch into the order scheduler services its tracks; requests
+    // on the same track keep their relative order. The scheduler's head
+    // position and direction carry over to the next batch.
+    void orderBatch(std::vector<BlockIO>& batch, DiskScheduler& scheduler) const {
+        std::map<int, std::deque<std::size_t>> byTrack;
+        std::vector<std::size_t> rejected;
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            int track = trackOf(batch[i].block);
+            if (scheduler.addRequest(track)) {
+                byTrack[track].push_back(i);
+            } else {
+                rejected.push_back(i);
+            }
+        }
+        std::vector<BlockIO> ordered;
+        ordered.reserve(batch.size());
+        for (int track : scheduler.serviceAll()) {
+            std::deque<std::size_t>& waiting = byTrack[track];
+            if (waiting.empty()) {
+                continue;   // Queued on the scheduler before this batch
+            }
+            ordered.push_back(batch[waiting.front()]);
+            waiting.pop_front();
+        }
+        // Blocks off the scheduler's disk go last, to fail in submitBatch
+        for (std::size_t i : rejected) {
+            ordered.push_back(batch[i]);
+        }
+        batch.swap(ordered);
+    }
+
+    // Runs every transfer in batch, in order, with up to queueDepth in
+    // flight; returns when all are done. Returns the number that failed.
+    int submitBatch(std::vector<BlockIO>& batch) {
+        Clock::time_point start = Clock::now();
+        bool ran = false;
+#ifdef VIRTUAL_DISK_IO_URING
+        if (ringReady) {
+            ran = runRing(batch);
+            if (!ran) {
+                // The ring is idle again; later batches use the thread pool
+                ring.close();
+                ringReady = false;
+                pool.reset(new ThreadPool(config.queueDepth));
+                ran = true;
+            }
+        }
+#endif
+        if (!ran) {
+            pool->run(*this, batch);
+        }
+        stats.seconds += since(start) / 1e9;
+        stats.batches++;
+
+        int failed = 0;
+        for (const BlockIO& io : batch) {
+            stats.requests++;
+            if (io.result == config.blockSize) {
+                stats.bytes += io.result;
+            } else {
+                failed++;
+            }
+        }
+        stats.errors += failed;
+        return failed;
+    }
+
+    // Writes dirty pages and drops the image from the page cache, so the
+    // next batch starts cold even without direct I/O
+    void dropCache() const {
+        fdatasync(fd);
+#ifdef POSIX_FADV_DONTNEED
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    }
+
+    const VirtualDiskStats& getStats() const { return stats; }
+    void resetStats() { stats = VirtualDiskStats(); }
+};
+
+#endif
@@ -0,0 +1,286 @@
+#ifndef VIRTUAL_MEMORY_H
+#define VIRTUAL_MEMORY_H
+
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include "Process.h"
+#include "MemoryAllocator.h"
+#include "MemoryManager.h"
+#include "PageTable.h"
+#include "Scheduler.h"
+
+struct VirtualMemoryConfig {
+    int referencesPerTimeUnit = 100;
+    int workingSetPages = 32;           // Pages a process is mostly touching at any time
+    double hotFraction = 0.9;           // References that go to the working set
+    double writeFraction = 0.3;
+    int phaseLength = 10000;            // References before the working set moves
+    double faultServiceTime = 0.05;     // Time units to read a faulting page in
+    double writeBackTime = 0.05;        // Time units to write a dirty victim out
+    unsigned seed = 1;
+};
+
+struct VirtualMemoryReport {
+    long long dispatches = 0;
+    long long references = 0;
+    long long faults = 0;
+    long long writeBacks = 0;
+    long long stallTime = 0;            // Time units processes spent blocked on paging
+    int backedProcesses = 0;
+    int deferredProcesses = 0;          // Waited for another process to free a region
+    int unbackedProcesses = 0;          // Never fitted; every reference faulted
+
+    double faultRate() const {
+        return references > 0 ? static_cast<double>(faults) / references : 0.0;
+    }
+};
+
+// Binds scheduling, allocation and paging into one model. When a process
+// arrives it reserves a region of Process::memorySize units from the
+// allocator (its memory image) and gets an address space of that many pages
+// in the page table. A process whose region does not fit is held out of the
+// ready queue until a completing process frees memory; if no other process
+// holds a region it runs without one and every reference faults. Each slice
+// issues page references into the address space. Its faults and dirty
+// write-backs then queue at a single paging device, and the process blocks
+// until they are serviced while the CPU runs someone else. A completed
+// process releases its region and frames.
+class VirtualMemorySystem {
+private:
+    struct Resident {
+        int regionStart;                // -1 if no region could be reserved
+        int pages;
+        uint64_t random;
+        int hotBase;
+        long long referencesMade;
+        double stallCarry;              // Fraction of a time unit not yet charged
+    };
+
+    MemoryAllocator& memory;
+    PageTable& pageTable;
+    VirtualMemoryConfig config;
+    std::unordered_map<int, Resident> residents;
+    int regionsHeld;
+    int dispatchTime;                   // Start of the slice being run
+    long long pagerFreeAt;              // When the paging device drains its queue
+    VirtualMemoryReport report;
+
+    // Admits a process to the wrapped policy only once its region is reserved
+    template <typename Policy>
+    class MemoryGate {
+    private:
+        struct Waiting {
+            int index;
+            const Process* process;
+            const ProcessState* state;
+        };
+
+        VirtualMemorySystem& vm;
+        Policy& policy;
+        std::deque<Waiting> waiting;    // Arrival order
+
+    public:
+        static constexpr bool preemptOnArrival = Policy::preemptOnArrival;
+
+        MemoryGate(VirtualMemorySystem& _vm, Policy& _policy) : vm(_vm), policy(_policy) {}
+
+        void reset(std::size_t processCount) {
+            policy.reset(processCount);
+            waiting.clear();
+        }
+
+        void admit(int index, const Process& p, const ProcessState& s, int now) {
+            if (vm.reserve(p, true)) {
+                policy.admit(index, p, s, now);
+            } else {
+                vm.report.deferredProcesses++;
+                waiting.push_back({index, &p, &s});
+            }
+        }
+
+        bool empty() const { return policy.empty(); }
+        int pickNext(int now) {
+            vm.dispatchTime = now;
+            return policy.pickNext(now);
+        }
+        int timeSlice(int index, const ProcessState& s) const { return policy.timeSlice(index, s); }
+
+        void requeue(int index, const Process& p, const ProcessState& s, int ran, int now) {
+            policy.requeue(index, p, s, ran, now);
+        }
+
+        // Frees p's memory and admits every waiting process that now fits
+        void release(const Process& p, int now) {
+            vm.release(p);
+            for (auto it = waiting.begin(); it != waiting.end();) {
+                if (vm.reserve(*it->process, true)) {
+                    policy.admit(it->index, *it->process, *it->state, now);
+                    it = waiting.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    };
+
+    // xorshift64*: per process, so a process's references do not depend on
+    // how the scheduler interleaves it with others
+    static uint64_t nextRandom(uint64_t& state) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+
+    // Compaction may move regions; keep region starts current
+    void applyRelocations() {
+        auto* linear = dynamic_cast<MemoryManager*>(&memory);
+        if (linear == nullptr) {
+            return;
+        }
+        for (const Relocation& move : linear->takeRelocations()) {
+            for (auto& entry : residents) {
+                if (entry.second.regionStart == move.oldStart) {
+                    entry.second.regionStart = move.newStart;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Reserves p's region. If it does not fit and canWait is set, returns
+    // false without admitting p as long as another process holds a region
+    // that will be freed; otherwise p is admitted without a region.
+    bool reserve(const Process& p, bool canWait) {
+        Resident resident = {-1, p.memorySize, 0, 0, 0, 0.0};
+        resident.random = (static_cast<uint64_t>(config.seed) << 32) ^ static_cast<uint64_t>(p.pid) ^ 0x9E3779B97F4A7C15ULL;
+        if (p.memorySize > 0) {
+            resident.regionStart = memory.allocateMemory(p.memorySize, p.name);
+            applyRelocations();
+            if (resident.regionStart >= 0) {
+                report.backedProcesses++;
+                regionsHeld++;
+            } else if (canWait && regionsHeld > 0) {
+                return false;
+            } else {
+                report.unbackedProcesses++;
+            }
+        }
+        residents.emplace(p.pid, resident);
+        return true;
+    }
+
+    // Issues count references from p, mostly into its current working set
+    void touchPages(const Process& p, Resident& resident, long long count) {
+        pageTable.switchAddressSpace(p.pid);
+        int hotPages = std::max(1, std::min(config.workingSetPages, resident.pages));
+        uint64_t hotThreshold = static_cast<uint64_t>(config.hotFraction * 4294967296.0);
+        uint64_t writeThreshold = static_cast<uint64_t>(config.writeFraction * 4294967296.0);
+        for (long long i = 0; i < count; i++) {
+            if (resident.referencesMade++ % config.phaseLength == 0) {
+                resident.hotBase = static_cast<int>(nextRandom(resident.random) % resident.pages);
+            }
+            uint64_t r = nextRandom(resident.random);
+            int page = (r & 0xffffffff) < hotThreshold
+                ? (resident.hotBase + static_cast<int>((r >> 32) % hotPages)) % resident.pages
+                : static_cast<int>((r >> 32) % resident.pages);
+            bool isWrite = (nextRandom(resident.random) & 0xffffffff) < writeThreshold;
+            pageTable.accessPage(page, isWrite);
+        }
+    }
+
+public:
+    VirtualMemorySystem(MemoryAllocator& _memory, PageTable& _pageTable,
+                        VirtualMemoryConfig _config = VirtualMemoryConfig())
+        : memory(_memory), pageTable(_pageTable), config(_config), regionsHeld(0), dispatchTime(0),
+          pagerFreeAt(0) {}
+
+    // Runs executeTime units of p and returns how long p then blocks on
+    // paging, in time units
+    int execute(const Process& p, int executeTime) {
+        auto it = residents.find(p.pid);
+        if (it == residents.end()) {
+            reserve(p, false);
+            it = residents.find(p.pid);
+        }
+        Resident& resident = it->second;
+        report.dispatches++;
+        if (resident.pages == 0) {
+            return 0;
+        }
+
+        long long count = static_cast<long long>(executeTime) * config.referencesPerTimeUnit;
+        long long faults = count;
+        long long writeBacks = 0;
+        if (resident.regionStart >= 0) {
+            long long faultsBefore = pageTable.getStats().faults;
+            long long writeBacksBefore = pageTable.getStats().writeBacks;
+            touchPages(p, resident, count);
+            faults = pageTable.getStats().faults - faultsBefore;
+            writeBacks = pageTable.getStats().writeBacks - writeBacksBefore;
+        }
+        report.references += count;
+        report.faults += faults;
+        report.writeBacks += writeBacks;
+
+        double service = faults * config.faultServiceTime + writeBacks * config.writeBackTime + resident.stallCarry;
+        int charged = static_cast<int>(service);
+        resident.stallCarry = service - charged;
+        if (charged == 0) {
+            return 0;
+        }
+        // Requests wait behind those of other processes at the pager
+        long long sliceEnd = static_cast<long long>(dispatchTime) + executeTime;
+        pagerFreeAt = std::max(pagerFreeAt, sliceEnd) + charged;
+        int stall = static_cast<int>(pagerFreeAt - sliceEnd);
+        report.stallTime += stall;
+        return stall;
+    }
+
+    // Frees the process's region and frames
+    void release(const Process& p) {
+        auto it = residents.find(p.pid);
+        if (it == residents.end()) {
+            return;
+        }
+        if (it->second.regionStart >= 0) {
+            memory.deallocateMemory(it->second.regionStart);
+            pageTable.releaseAddressSpace(p.pid);
+            regionsHeld--;
+        }
+        residents.erase(it);
+        applyRelocations();
+    }
+
+    // Schedules every process on scheduler with the given policy, running
+    // each slice through this memory system
+    template <typename Policy>
+    void run(Scheduler& scheduler, Policy& policy) {
+        MemoryGate<Policy> gate(*this, policy);
+        scheduler.run(gate,
+                      [&gate](const Process& p, int now) { gate.release(p, now); },
+                      [this](const Process& p, int executeTime) { return execute(p, executeTime); });
+    }
+
+    const VirtualMemoryReport& getReport() const { return report; }
+
+    void displayReport() const {
+        std::cout << "\n=== Virtual Memory ===\n";
+        std::cout << "Processes:          " << report.backedProcesses << " with memory ("
+                  << report.deferredProcesses << " waited for it), "
+                  << report.unbackedProcesses << " without a region\n";
+        std::cout << "References:         " << report.references << "\n";
+        std::cout << "Page Faults:        " << report.faults << "\n";
+        std::cout << "Write-backs:        " << report.writeBacks << "\n";
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Fault Rate:         " << report.faultRate() * 100 << "%\n";
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << "Paging Stall Time:  " << report.stallTime << " time units\n";
+    }
+};
+
+#endif
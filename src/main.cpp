@@ -1,8 +1,16 @@
 #include "Process.h"
 #include "Scheduler.h"
+#include "ParameterSweep.h"
 #include "MemoryManager.h"
+#include "IndexedMemoryManager.h"
+#include "BuddyMemoryManager.h"
+#include "SlabAllocator.h"
+#include "ConcurrentMemoryManager.h"
 #include "PageTable.h"
+#include "VirtualMemory.h"
 #include "DiskScheduler.h"
+#include "IOScheduler.h"
+#include "BufferCache.h"
 #include "ConsoleUI.h"
 #include "SecuritySystem.h"
 #include "LoginUI.h"
@@ -10,6 +18,9 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <memory>
+#include <iomanip>
+#include <algorithm>
 
 class OSSimulation
 {
@@ -17,18 +28,23 @@ private:
     ConsoleUI ui;
     SecuritySystem security;
     Scheduler scheduler;
-    MemoryManager memoryManager;
+    std::unique_ptr<MemoryAllocator> memoryManager;
     PageTable pageTable;
     DiskScheduler diskScheduler;
+    BufferCache bufferCache;
     std::vector<Process> processes;
     int nextPID;
 
 public:
     OSSimulation() : scheduler(2),
-                     memoryManager(1024),
+                     memoryManager(new MemoryManager(1024)),
                      pageTable(256),
                      diskScheduler(0),
-                     nextPID(1) {}
+                     bufferCache(diskScheduler),
+                     nextPID(1)
+    {
+        pageTable.enableTLB(TLBConfig());
+    }
 
     void run()
     {
@@ -215,7 +231,7 @@ private:
             case 1:
             {
                 std::string name;
-                int priority, burstTime;
+                int priority, burstTime, memorySize;
 
                 std::cout << "Enter process name: ";
                 std::getline(std::cin, name);
@@ -223,8 +239,11 @@ private:
                 std::cin >> priority;
                 std::cout << "Enter burst time: ";
                 std::cin >> burstTime;
+                std::cout << "Enter memory size in pages (0 for none): ";
+                std::cin >> memorySize;
 
                 Process newProcess(nextPID++, name, priority, burstTime, 0);
+                newProcess.memorySize = std::max(0, memorySize);
                 processes.push_back(newProcess);
                 scheduler.addProcess(newProcess);
 
@@ -257,6 +276,118 @@ private:
                 break;
             }
             case 4:
+            {
+                std::cout << "\nComparing scheduling policies on the current workload...\n\n";
+                Scheduler::displaySummaries(scheduler.comparePolicies());
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 5:
+            {
+                SMPConfig config;
+                std::cout << "Enter number of cores: ";
+                std::cin >> config.cores;
+                std::cout << "Enter random seed: ";
+                std::cin >> config.seed;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+                std::cout << "\nExecuting Multi-Core Round Robin Scheduling...\n\n";
+                SMPScheduler::displayReport(scheduler.runSMP(config));
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 6:
+            {
+                std::string path;
+                std::cout << "Enter trace file (CSV or binary): ";
+                std::getline(std::cin, path);
+
+                TraceReader trace;
+                if (!trace.open(path))
+                {
+                    std::cout << "Could not open trace file!\n";
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                    break;
+                }
+
+                std::cout << "\nReplaying trace with Round Robin Scheduling...\n\n";
+                Scheduler replayScheduler(2);
+                RoundRobinPolicy policy(2);
+                replayScheduler.replay(trace, policy, [](const Process &, int) {});
+                replayScheduler.getMetrics().writeReport(std::cout);
+                if (trace.getMalformedLines() > 0)
+                {
+                    std::cout << "Skipped " << trace.getMalformedLines() << " malformed lines\n";
+                }
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 7:
+            {
+                std::cout << "\nSweeping time quantum over every policy...\n\n";
+                ParameterSweep sweep(std::make_shared<const std::vector<Process>>(scheduler.getProcesses()));
+                ParameterSweep::displayResults(sweep.run({1, 2, 4, 8, 16}, ParameterSweep::allPolicies()));
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 8:
+            {
+                int parentPid;
+                std::cout << "Enter PID of the process to fork: ";
+                std::cin >> parentPid;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+                auto parent = std::find_if(processes.begin(), processes.end(),
+                                           [parentPid](const Process &p) { return p.pid == parentPid; });
+                if (parent == processes.end())
+                {
+                    std::cout << "No process with PID " << parentPid << "!\n";
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                    break;
+                }
+
+                Process child(nextPID++, parent->name + "-child", parent->priority, parent->burstTime, 0);
+                child.memorySize = parent->memorySize;
+                long long savedBefore = pageTable.framesSaved();
+                bool shared = pageTable.fork(parent->pid, child.pid);
+                processes.push_back(child);
+                scheduler.addProcess(child);
+
+                std::cout << "Forked process " << child.pid << " from " << parentPid << ".\n";
+                if (shared)
+                {
+                    std::cout << pageTable.framesSaved() - savedBefore
+                              << " frames shared copy-on-write.\n";
+                }
+                else
+                {
+                    std::cout << "The parent has no address space yet; the child starts empty.\n";
+                }
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                break;
+            }
+            case 9:
+            {
+                std::cout << "\nExecuting Round Robin Scheduling with virtual memory...\n\n";
+                Scheduler vmScheduler(2);
+                for (const auto &p : processes)
+                {
+                    vmScheduler.addProcess(p);
+                }
+                RoundRobinPolicy policy(2);
+                VirtualMemorySystem vm(*memoryManager, pageTable);
+                vm.run(vmScheduler, policy);
+                vmScheduler.getMetrics().writeReport(std::cout);
+                vm.displayReport();
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 10:
                 return;
             default:
                 std::cout << "Invalid choice! Please try again.\n";
@@ -265,15 +396,31 @@ private:
         }
     }
 
-    void handleMemoryManagement(MemoryManager &memoryManager)
+    // Compaction may move blocks; print their new addresses
+    void reportRelocations(MemoryAllocator &allocator)
+    {
+        auto *linear = dynamic_cast<MemoryManager *>(&allocator);
+        if (!linear)
+        {
+            return;
+        }
+        for (const Relocation &move : linear->takeRelocations())
+        {
+            std::cout << "Compaction moved " << move.processName << " from address "
+                      << move.oldStart << " to " << move.newStart << "\n";
+        }
+    }
+
+    void handleMemoryManagement(std::unique_ptr<MemoryAllocator> &memoryManager)
     {
         while (true)
         {
-            std::cout << "\n=== Memory Management ===\n";
+            std::cout << "\n=== Memory Management (" << memoryManager->name() << ") ===\n";
             std::cout << "1. Allocate Memory\n";
             std::cout << "2. Deallocate Memory\n";
             std::cout << "3. Display Memory Map\n";
-            std::cout << "4. Return to Main Menu\n";
+            std::cout << "4. Select Allocator\n";
+            std::cout << "5. Return to Main Menu\n";
             std::cout << "Enter choice: ";
 
             int choice;
@@ -290,7 +437,7 @@ private:
                 std::cout << "Enter process name: ";
                 std::cin >> processName;
 
-                int address = memoryManager.allocateMemory(size, processName);
+                int address = memoryManager->allocateMemory(size, processName);
                 if (address != -1)
                 {
                     std::cout << "Memory allocated at address "
@@ -300,6 +447,7 @@ private:
                 {
                     std::cout << "Memory allocation failed!\n";
                 }
+                reportRelocations(*memoryManager);
                 break;
             }
             case 2:
@@ -308,7 +456,7 @@ private:
                 std::cout << "Enter memory address to deallocate: ";
                 std::cin >> address;
 
-                if (memoryManager.deallocateMemory(address))
+                if (memoryManager->deallocateMemory(address))
                 {
                     std::cout << "Memory at address "
                               << address << " deallocated successfully!\n";
@@ -317,12 +465,81 @@ private:
                 {
                     std::cout << "Memory deallocation failed!\n";
                 }
+                reportRelocations(*memoryManager);
                 break;
             }
             case 3:
-                memoryManager.displayMemoryMap();
+            {
+                memoryManager->displayMemoryMap();
+                MemoryStats stats = memoryManager->getStats();
+                std::cout << "Free Blocks: " << stats.freeBlocks
+                          << "  Largest Free Block: " << stats.largestFreeBlock << " MB\n";
+                std::cout << std::fixed << std::setprecision(1)
+                          << "External Fragmentation: " << stats.externalFragmentation() * 100 << "%\n"
+                          << "Internal Fragmentation: " << stats.internalFragmentation() * 100 << "%"
+                          << " (" << stats.requestedMemory << " MB requested of "
+                          << stats.allocatedMemory << " MB allocated)\n";
+                std::cout.unsetf(std::ios::floatfield);
+                if (auto *linear = dynamic_cast<MemoryManager *>(memoryManager.get()))
+                {
+                    const CompactionStats &compaction = linear->getCompactionStats();
+                    std::cout << "Compaction: " << compaction.blocksMoved << " blocks / "
+                              << compaction.bytesMoved << " MB moved in " << compaction.steps << " steps, "
+                              << compaction.failuresAvoided << " failures avoided, "
+                              << compaction.failures << " failures\n";
+                }
                 break;
+            }
             case 4:
+            {
+                std::cout << "1. First Fit (linear)\n";
+                std::cout << "2. First Fit (indexed)\n";
+                std::cout << "3. Best Fit (indexed)\n";
+                std::cout << "4. Worst Fit (indexed)\n";
+                std::cout << "5. Next Fit (indexed)\n";
+                std::cout << "6. Buddy System\n";
+                std::cout << "7. Slab (small sizes over first fit)\n";
+                std::cout << "8. First Fit (linear, incremental compaction)\n";
+                std::cout << "9. Concurrent (thread caches over first fit)\n";
+                std::cout << "Select allocator (current memory contents are discarded): ";
+
+                int allocatorChoice;
+                std::cin >> allocatorChoice;
+                switch (allocatorChoice)
+                {
+                case 1:
+                    memoryManager.reset(new MemoryManager(1024));
+                    break;
+                case 2:
+                    memoryManager.reset(new IndexedMemoryManager(1024, FitStrategy::FIRST_FIT));
+                    break;
+                case 3:
+                    memoryManager.reset(new IndexedMemoryManager(1024, FitStrategy::BEST_FIT));
+                    break;
+                case 4:
+                    memoryManager.reset(new IndexedMemoryManager(1024, FitStrategy::WORST_FIT));
+                    break;
+                case 5:
+                    memoryManager.reset(new IndexedMemoryManager(1024, FitStrategy::NEXT_FIT));
+                    break;
+                case 6:
+                    memoryManager.reset(new BuddyMemoryManager(1024));
+                    break;
+                case 7:
+                    memoryManager.reset(new SlabAllocator(1024));
+                    break;
+                case 8:
+                    memoryManager.reset(new MemoryManager(1024, 64));
+                    break;
+                case 9:
+                    memoryManager.reset(new ConcurrentMemoryManager(1024));
+                    break;
+                default:
+                    std::cout << "Invalid choice! Allocator unchanged.\n";
+                }
+                break;
+            }
+            case 5:
                 return;
             }
         }
@@ -330,50 +547,333 @@ private:
 
     void handleDiskManagement()
     {
-        std::cout << "\nDisk Management\n";
-        std::cout << "Enter disk request positions (enter -1 to stop):\n";
-
-        int position;
         while (true)
         {
-            std::cout << "Position: ";
-            std::cin >> position;
+            std::cout << "\n=== Disk Management (" << diskPolicyName(diskScheduler.getPolicy())
+                      << ", head at " << diskScheduler.getPosition() << ", "
+                      << diskScheduler.pendingRequests() << " pending) ===\n";
+            std::cout << "1. Read Blocks\n";
+            std::cout << "2. Write Blocks\n";
+            std::cout << "3. Flush Dirty Blocks\n";
+            std::cout << "4. Service Next Request\n";
+            std::cout << "5. Service All Pending Requests\n";
+            std::cout << "6. Select Scheduling Policy\n";
+            std::cout << "7. Configure Buffer Cache\n";
+            std::cout << "8. Show Disk Statistics\n";
+            std::cout << "9. Compare Timed I/O Schedulers\n";
+            std::cout << "10. Return to Main Menu\n";
+            std::cout << "Enter choice: ";
 
-            if (position == -1)
-                break;
-            diskScheduler.addRequest(position);
-        }
+            int choice;
+            std::cin >> choice;
 
-        std::vector<int> sequence = diskScheduler.executeSCAN();
-        std::cout << "\nSCAN Algorithm Sequence: ";
-        for (int pos : sequence)
-        {
-            std::cout << pos << " ";
+            switch (choice)
+            {
+            case 1:
+            case 2:
+            {
+                bool isWrite = choice == 2;
+                std::cout << "Enter block numbers 0-" << diskScheduler.getTrackCount() - 1
+                          << " to " << (isWrite ? "write" : "read") << " (enter -1 to stop):\n";
+                int block;
+                while (true)
+                {
+                    std::cout << "Block: ";
+                    std::cin >> block;
+
+                    if (block == -1)
+                        break;
+                    if (block < 0 || block >= diskScheduler.getTrackCount())
+                    {
+                        std::cout << "Block " << block << " is not on the disk.\n";
+                    }
+                    else if (isWrite ? bufferCache.write(block) : bufferCache.read(block))
+                    {
+                        std::cout << "Cache hit.\n";
+                    }
+                    else
+                    {
+                        std::cout << (isWrite ? "Cached as dirty.\n" : "Cache miss; disk read queued.\n");
+                    }
+                }
+                break;
+            }
+            case 3:
+                std::cout << bufferCache.flush() << " dirty blocks queued for write-back.\n";
+                break;
+            case 4:
+            {
+                int track = diskScheduler.serviceNext();
+                if (track < 0)
+                {
+                    std::cout << "No pending requests.\n";
+                }
+                else
+                {
+                    std::cout << "Serviced track " << track << ".\n";
+                }
+                break;
+            }
+            case 5:
+            {
+                std::vector<int> sequence = diskScheduler.serviceAll();
+                std::cout << "\n" << diskPolicyName(diskScheduler.getPolicy()) << " Sequence: ";
+                for (int pos : sequence)
+                {
+                    std::cout << pos << " ";
+                }
+                std::cout << "\nTotal head movement: " << diskScheduler.getStats().headMovement << " tracks\n";
+                break;
+            }
+            case 6:
+            {
+                std::cout << "1. SSTF\n";
+                std::cout << "2. SCAN\n";
+                std::cout << "3. C-SCAN\n";
+                std::cout << "4. LOOK\n";
+                std::cout << "5. C-LOOK\n";
+                std::cout << "Select scheduling policy (pending requests are kept): ";
+
+                int policyChoice;
+                std::cin >> policyChoice;
+                if (policyChoice < 1 || policyChoice > 5)
+                {
+                    std::cout << "Invalid choice! Policy unchanged.\n";
+                    break;
+                }
+                diskScheduler.setPolicy(static_cast<DiskPolicy>(policyChoice - 1));
+                break;
+            }
+            case 7:
+            {
+                BufferCacheConfig config;
+                int capacity, readAhead, writeBackBatch, policyChoice;
+                std::cout << "Enter cache capacity in blocks: ";
+                std::cin >> capacity;
+                std::cout << "Enter read-ahead in blocks (0 for none): ";
+                std::cin >> readAhead;
+                if (capacity <= 0 || readAhead < 0)
+                {
+                    std::cout << "Invalid cache size! Buffer cache unchanged.\n";
+                    break;
+                }
+                std::cout << "Enter dirty blocks per write-back batch: ";
+                std::cin >> writeBackBatch;
+                config.capacity = static_cast<std::size_t>(capacity);
+                config.readAhead = readAhead;
+                config.writeBackBatch = static_cast<std::size_t>(std::max(1, writeBackBatch));
+                std::cout << "1. LRU\n";
+                std::cout << "2. CLOCK\n";
+                std::cout << "3. ARC\n";
+                std::cout << "Select replacement policy: ";
+                std::cin >> policyChoice;
+
+                std::unique_ptr<CacheReplacement> policy;
+                if (policyChoice == 2)
+                    policy.reset(new ClockCacheReplacement());
+                else if (policyChoice == 3)
+                    policy.reset(new ARCCacheReplacement());
+                else
+                    policy.reset(new LRUCacheReplacement());
+                bufferCache.reconfigure(config, std::move(policy));
+                std::cout << "Buffer cache reconfigured; dirty blocks were flushed.\n";
+                break;
+            }
+            case 8:
+                diskScheduler.displayStats();
+                bufferCache.displayStats();
+                break;
+            case 9:
+            {
+                MixedWorkloadConfig config;
+                std::cout << "Enter number of sequential readers: ";
+                std::cin >> config.readers;
+                std::cout << "Enter random writes per second: ";
+                std::cin >> config.writesPerSecond;
+
+                IOSimulator simulator;
+                std::vector<IORequest> workload = generateMixedWorkload(simulator.getDisk(), config);
+                FCFSIOPolicy fcfs;
+                LookIOPolicy look;
+                DeadlineIOPolicy deadline;
+                AnticipatoryIOPolicy anticipatory;
+                std::cout << "\nSimulating " << workload.size() << " requests...\n\n";
+                IOSimulator::displayReports({simulator.run(workload, fcfs), simulator.run(workload, look),
+                                             simulator.run(workload, deadline), simulator.run(workload, anticipatory)});
+                break;
+            }
+            case 10:
+                return;
+            default:
+                std::cout << "Invalid choice! Please try again.\n";
+            }
         }
-        std::cout << "\n\nPress Enter to continue...";
-        std::cin.ignore();
-        std::cin.get();
     }
 
     void handlePageTableOperations()
     {
-        std::cout << "\nPage Table Operations\n";
-        int pageNum;
-        std::cout << "Enter page number to allocate: ";
-        std::cin >> pageNum;
-
-        if (pageTable.allocatePage(pageNum))
-        {
-            std::cout << "Page " << pageNum << " allocated successfully!\n";
-        }
-        else
+        while (true)
         {
-            std::cout << "Page allocation failed!\n";
-        }
+            std::cout << "\n=== Page Table Operations (" << pageTable.getPolicy().name()
+                      << ", pid " << pageTable.getCurrentPid() << ") ===\n";
+            std::cout << "1. Allocate Page\n";
+            std::cout << "2. Access Page\n";
+            std::cout << "3. Show Paging Statistics\n";
+            std::cout << "4. Select Replacement Policy\n";
+            std::cout << "5. Switch Process\n";
+            std::cout << "6. Configure TLB\n";
+            std::cout << "7. Replay Reference Trace\n";
+            std::cout << "8. Return to Main Menu\n";
+            std::cout << "Enter choice: ";
+
+            int choice;
+            std::cin >> choice;
+
+            switch (choice)
+            {
+            case 1:
+            {
+                int pageNum;
+                std::cout << "Enter page number to allocate: ";
+                std::cin >> pageNum;
 
-        std::cout << "\nPress Enter to continue...";
-        std::cin.ignore();
-        std::cin.get();
+                if (pageTable.allocatePage(pageNum))
+                {
+                    std::cout << "Page " << pageNum << " allocated successfully!\n";
+                }
+                else
+                {
+                    std::cout << "Page allocation failed!\n";
+                }
+                break;
+            }
+            case 2:
+            {
+                int pageNum;
+                char mode;
+                std::cout << "Enter page number to access: ";
+                std::cin >> pageNum;
+                std::cout << "Read or write (r/w): ";
+                std::cin >> mode;
+
+                long long evictions = pageTable.getStats().evictions;
+                if (pageTable.accessPage(pageNum, mode == 'w' || mode == 'W'))
+                {
+                    std::cout << "Page " << pageNum << " hit.\n";
+                }
+                else
+                {
+                    std::cout << "Page fault on page " << pageNum << "; page loaded";
+                    if (pageTable.getStats().evictions > evictions)
+                    {
+                        std::cout << " after evicting a victim";
+                    }
+                    std::cout << ".\n";
+                }
+                break;
+            }
+            case 3:
+                pageTable.displayStats();
+                break;
+            case 4:
+            {
+                std::cout << "1. FIFO\n";
+                std::cout << "2. Clock (second chance)\n";
+                std::cout << "3. LRU\n";
+                std::cout << "4. Aging\n";
+                std::cout << "Select replacement policy (resident pages are kept): ";
+
+                int policyChoice;
+                std::cin >> policyChoice;
+                switch (policyChoice)
+                {
+                case 1:
+                    pageTable.setPolicy(std::unique_ptr<ReplacementPolicy>(new FIFOReplacement()));
+                    break;
+                case 2:
+                    pageTable.setPolicy(std::unique_ptr<ReplacementPolicy>(new ClockReplacement()));
+                    break;
+                case 3:
+                    pageTable.setPolicy(std::unique_ptr<ReplacementPolicy>(new LRUReplacement()));
+                    break;
+                case 4:
+                    pageTable.setPolicy(std::unique_ptr<ReplacementPolicy>(new AgingReplacement()));
+                    break;
+                default:
+                    std::cout << "Invalid choice! Policy unchanged.\n";
+                }
+                break;
+            }
+            case 5:
+            {
+                int pid;
+                std::cout << "Enter process ID: ";
+                std::cin >> pid;
+                pageTable.switchAddressSpace(pid);
+                std::cout << "Now using the address space of process " << pid << ".\n";
+                break;
+            }
+            case 6:
+            {
+                TLBConfig config;
+                char replacement, tagging;
+                std::cout << "Enter TLB entries (0 to disable): ";
+                std::cin >> config.entries;
+                if (config.entries <= 0)
+                {
+                    pageTable.disableTLB();
+                    std::cout << "TLB disabled.\n";
+                    break;
+                }
+                std::cout << "Enter associativity (ways per set): ";
+                std::cin >> config.ways;
+                std::cout << "Replacement, LRU or random (l/r): ";
+                std::cin >> replacement;
+                std::cout << "Tag entries with ASIDs instead of flushing on context switch (y/n): ";
+                std::cin >> tagging;
+                config.replacement = replacement == 'r' || replacement == 'R' ? TLBReplacement::RANDOM
+                                                                              : TLBReplacement::LRU;
+                config.asidTagging = tagging == 'y' || tagging == 'Y';
+                pageTable.enableTLB(config);
+                std::cout << "TLB reconfigured; cached translations discarded.\n";
+                break;
+            }
+            case 7:
+            {
+                std::string path;
+                long long window;
+                std::cout << "Enter trace file path: ";
+                std::cin >> path;
+                std::cout << "Enter window size (references): ";
+                std::cin >> window;
+
+                ReferenceTrace trace;
+                if (!trace.open(path))
+                {
+                    std::cout << "Could not open " << path << "\n";
+                    break;
+                }
+                ReplayReport report = pageTable.replay(trace, window);
+                std::cout << "References: " << report.references << "  Faults: " << report.faults
+                          << "  Write-backs: " << report.writeBacks << "\n";
+                if (report.rejected > 0 || trace.getMalformedLines() > 0)
+                {
+                    std::cout << "Skipped " << report.rejected << " references outside the address space and "
+                              << trace.getMalformedLines() << " malformed lines\n";
+                }
+                std::cout << std::fixed << std::setprecision(4) << "Fault rate by window:";
+                for (std::size_t w = 0; w < report.windows.size(); w++)
+                {
+                    std::cout << (w % 10 == 0 ? "\n  " : " ") << report.windows[w].faultRate();
+                }
+                std::cout << "\n";
+                std::cout.unsetf(std::ios::floatfield);
+                break;
+            }
+            case 8:
+                return;
+            }
+        }
     }
 };
 
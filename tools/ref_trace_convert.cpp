@@ -0,0 +1,22 @@
+// Converts a CSV memory-reference trace (page,op with op R or W) into the
+// compact binary format read by ReferenceTrace.
+// Build: g++ -std=c++17 -O2 -Isrc tools/ref_trace_convert.cpp -o ref_trace_convert
+// Usage: ref_trace_convert <input.csv> <output.refs>
+
+#include "ReferenceTrace.h"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.csv> <output.refs>\n";
+        return 1;
+    }
+
+    long long written = ReferenceTrace::convertCsvToBinary(argv[1], argv[2]);
+    if (written < 0) {
+        std::cerr << "Could not open " << argv[1] << " or " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << written << " references to " << argv[2] << "\n";
+    return 0;
+}
@@ -0,0 +1,22 @@
+// Converts a CSV workload trace (pid,name,priority,burst,arrival) into the
+// compact binary format read by TraceReader.
+// Build: g++ -std=c++17 -O2 -Isrc tools/trace_convert.cpp -o trace_convert
+// Usage: trace_convert <input.csv> <output.trace>
+
+#include "TraceReader.h"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.csv> <output.trace>\n";
+        return 1;
+    }
+
+    long long written = TraceReader::convertCsvToBinary(argv[1], argv[2]);
+    if (written < 0) {
+        std::cerr << "Could not open " << argv[1] << " or " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << written << " records to " << argv[2] << "\n";
+    return 0;
+}